@@ -2,7 +2,8 @@ pub mod error;
 
 use rust_socketio::{ClientBuilder, Payload};
 use std::collections::VecDeque;
-use std::sync::{Arc, RwLock};
+use std::sync::{Arc, Condvar, Mutex, RwLock};
+use std::time::Duration;
 use tracing::error;
 
 use crate::error::ClientError;
@@ -22,33 +23,57 @@ pub enum WarhorseEvent {
     ChatMessage(ChatMessage),
 }
 
+type EventQueue = Arc<RwLock<VecDeque<WarhorseEvent>>>;
+type EventSignal = Arc<(Mutex<bool>, Condvar)>;
+
 pub struct WarhorseClient {
     // events we've received but haven't processed yet
-    pending_receives: Arc<RwLock<VecDeque<WarhorseEvent>>>,
+    pending_receives: EventQueue,
     // messages we've queued to send but haven't yet
     pending_sends: std::sync::mpsc::Sender<(String, serde_json::Value)>,
+    // signaled whenever an event is queued, so consumers can block on
+    // wait_for_events instead of sleep-polling pump
+    event_signal: EventSignal,
 }
 
 impl WarhorseClient {
+    fn push_event(queue: &EventQueue, signal: &EventSignal, event: WarhorseEvent) {
+        if let Ok(mut event_queue) = queue.write() {
+            event_queue.push_back(event);
+        }
+        let (lock, cvar) = &**signal;
+        if let Ok(mut signaled) = lock.lock() {
+            *signaled = true;
+            cvar.notify_one();
+        }
+    }
+
     pub fn new(connection_string: &str) -> Result<Self, ClientError> {
         let pending_events = Arc::new(RwLock::new(VecDeque::new()));
+        let event_signal: EventSignal = Arc::new((Mutex::new(false), Condvar::new()));
         let socket_io = ClientBuilder::new(connection_string)
             .namespace("/")
             .on(EVENT_RECEIVE_USER_LOGIN, {
                 let pending_events_clone = pending_events.clone();
+                let event_signal_clone = event_signal.clone();
                 move |_payload, _socket| {
-                    if let Ok(mut event_queue) = pending_events_clone.write() {
-                        event_queue.push_back(WarhorseEvent::LoggedIn);
-                    }
+                    Self::push_event(
+                        &pending_events_clone,
+                        &event_signal_clone,
+                        WarhorseEvent::LoggedIn,
+                    );
                 }
             })
             .on(EVENT_RECEIVE_HELLO, {
                 let pending_events_clone = pending_events.clone();
+                let event_signal_clone = event_signal.clone();
                 move |payload, _socket| match payload {
                     Payload::Text(_) => {
-                        if let Ok(mut event_queue) = pending_events_clone.write() {
-                            event_queue.push_back(WarhorseEvent::Hello);
-                        }
+                        Self::push_event(
+                            &pending_events_clone,
+                            &event_signal_clone,
+                            WarhorseEvent::Hello,
+                        );
                     }
                     _ => {
                         error!("Unexpected payload: {:?}", payload);
@@ -57,14 +82,17 @@ impl WarhorseClient {
             })
             .on(EVENT_RECEIVE_ERROR, {
                 let pending_events_clone = pending_events.clone();
+                let event_signal_clone = event_signal.clone();
                 move |payload, _socket| match payload {
                     Payload::Text(text) => {
                         for line in text {
                             match RequestError::from_json(line.clone()) {
                                 Ok(e) => {
-                                    if let Ok(mut event_queue) = pending_events_clone.write() {
-                                        event_queue.push_back(WarhorseEvent::Error(e.0));
-                                    }
+                                    Self::push_event(
+                                        &pending_events_clone,
+                                        &event_signal_clone,
+                                        WarhorseEvent::Error(e.0),
+                                    );
                                 }
                                 Err(e) => error!("Failed to parse error: {:?}", e),
                             }
@@ -77,14 +105,17 @@ impl WarhorseClient {
             })
             .on(EVENT_RECEIVE_FRIENDS, {
                 let pending_events_clone = pending_events.clone();
+                let event_signal_clone = event_signal.clone();
                 move |payload, _socket| match payload {
                     Payload::Text(text) => {
                         if let Some(first) = text.first() {
                             match json_to_vec::<Friend>(first.clone()) {
                                 Ok(friends) => {
-                                    if let Ok(mut event_queue) = pending_events_clone.write() {
-                                        event_queue.push_back(WarhorseEvent::FriendsList(friends));
-                                    }
+                                    Self::push_event(
+                                        &pending_events_clone,
+                                        &event_signal_clone,
+                                        WarhorseEvent::FriendsList(friends),
+                                    );
                                 }
                                 Err(e) => {
                                     error!("Failed to parse friends list: {:?}", e);
@@ -99,19 +130,18 @@ impl WarhorseClient {
             })
             .on(EVENT_RECEIVE_FRIEND_REQUESTS, {
                 let pending_events_clone = pending_events.clone();
+                let event_signal_clone = event_signal.clone();
                 move |payload, _socket| match payload {
                     Payload::Text(text) => {
                         if let Some(first) = text.first() {
                             match json_to_vec::<Friend>(first.clone()) {
                                 Ok(mut friend_requests) => {
                                     if let Some(friend_request) = friend_requests.pop() {
-                                        if let Ok(mut event_queue) = pending_events_clone.write() {
-                                            event_queue.push_back(
-                                                WarhorseEvent::FriendRequestReceived(
-                                                    friend_request,
-                                                ),
-                                            );
-                                        }
+                                        Self::push_event(
+                                            &pending_events_clone,
+                                            &event_signal_clone,
+                                            WarhorseEvent::FriendRequestReceived(friend_request),
+                                        );
                                     }
                                 }
                                 Err(e) => {
@@ -127,17 +157,18 @@ impl WarhorseClient {
             })
             .on(EVENT_RECEIVE_FRIEND_REQUEST_ACCEPTED, {
                 let pending_events_clone = pending_events.clone();
+                let event_signal_clone = event_signal.clone();
                 move |payload, _socket| match payload {
                     Payload::Text(text) => {
                         if let Some(first) = text.first() {
                             match json_to_vec::<Friend>(first.clone()) {
                                 Ok(mut friends) => {
                                     if let Some(friend) = friends.pop() {
-                                        if let Ok(mut event_queue) = pending_events_clone.write() {
-                                            event_queue.push_back(
-                                                WarhorseEvent::FriendRequestAccepted(friend),
-                                            );
-                                        }
+                                        Self::push_event(
+                                            &pending_events_clone,
+                                            &event_signal_clone,
+                                            WarhorseEvent::FriendRequestAccepted(friend),
+                                        );
                                     }
                                 }
                                 Err(e) => {
@@ -153,15 +184,17 @@ impl WarhorseClient {
             })
             .on(EVENT_RECEIVE_CHAT_MESSAGE, {
                 let pending_events_clone = pending_events.clone();
+                let event_signal_clone = event_signal.clone();
                 move |payload, _socket| match payload {
                     Payload::Text(text) => {
                         if let Some(first) = text.first() {
                             match ChatMessage::from_json(first.clone()) {
                                 Ok(chat_message) => {
-                                    if let Ok(mut event_queue) = pending_events_clone.write() {
-                                        event_queue
-                                            .push_back(WarhorseEvent::ChatMessage(chat_message));
-                                    }
+                                    Self::push_event(
+                                        &pending_events_clone,
+                                        &event_signal_clone,
+                                        WarhorseEvent::ChatMessage(chat_message),
+                                    );
                                 }
                                 Err(e) => {
                                     error!("Failed to parse chat message: {:?}", e);
@@ -201,9 +234,35 @@ impl WarhorseClient {
         Ok(WarhorseClient {
             pending_receives: pending_events,
             pending_sends: sender,
+            event_signal,
         })
     }
 
+    /// Blocks until at least one event is queued or the timeout elapses.
+    /// Returns true if events are waiting to be pumped.
+    pub fn wait_for_events(&self, timeout: Duration) -> bool {
+        // fast path: something is already queued
+        if let Ok(event_queue) = self.pending_receives.read() {
+            if !event_queue.is_empty() {
+                return true;
+            }
+        }
+
+        let (lock, cvar) = &*self.event_signal;
+        let Ok(mut signaled) = lock.lock() else {
+            return false;
+        };
+        if !*signaled {
+            match cvar.wait_timeout(signaled, timeout) {
+                Ok((guard, _)) => signaled = guard,
+                Err(_) => return false,
+            }
+        }
+        let had_events = *signaled;
+        *signaled = false;
+        had_events
+    }
+
     pub fn send_user_login_request(
         &self,
         username: String,
@@ -344,15 +403,88 @@ impl WarhorseClient {
     }
 
     pub fn pump(&self) -> Vec<WarhorseEvent> {
+        self.pump_limited(usize::MAX)
+    }
+
+    /// Pops at most max_events events; anything beyond that stays queued
+    /// for the next pump instead of being dropped.
+    pub fn pump_limited(&self, max_events: usize) -> Vec<WarhorseEvent> {
         let mut events = Vec::new();
         if let Ok(mut event_queue) = self.pending_receives.write() {
-            while let Some(event) = event_queue.pop_front() {
-                events.push(event);
+            while events.len() < max_events {
+                match event_queue.pop_front() {
+                    Some(event) => events.push(event),
+                    None => break,
+                }
             }
         }
         events
     }
 
+    /// Priority-tiered pump: control events (everything except chat) are
+    /// delivered first and in full, bulk chat traffic is capped at
+    /// bulk_budget per pump, and with drop_oldest the stalest chat backlog
+    /// beyond the budget is discarded instead of queued. Keeps
+    /// time-to-interactive after a reconnect bounded regardless of how much
+    /// chat piled up.
+    pub fn pump_prioritized(
+        &self,
+        max_events: usize,
+        bulk_budget: usize,
+        drop_oldest: bool,
+    ) -> Vec<WarhorseEvent> {
+        let mut delivered = Vec::new();
+        if let Ok(mut event_queue) = self.pending_receives.write() {
+            let mut control = VecDeque::new();
+            let mut bulk = VecDeque::new();
+            while let Some(event) = event_queue.pop_front() {
+                match event {
+                    WarhorseEvent::ChatMessage(_) => bulk.push_back(event),
+                    _ => control.push_back(event),
+                }
+            }
+
+            if drop_oldest && bulk.len() > bulk_budget {
+                let excess = bulk.len() - bulk_budget;
+                bulk.drain(..excess);
+            }
+
+            while delivered.len() < max_events {
+                match control.pop_front() {
+                    Some(event) => delivered.push(event),
+                    None => break,
+                }
+            }
+            let mut chat_taken = 0;
+            while delivered.len() < max_events && chat_taken < bulk_budget {
+                match bulk.pop_front() {
+                    Some(event) => {
+                        delivered.push(event);
+                        chat_taken += 1;
+                    }
+                    None => break,
+                }
+            }
+
+            // anything undelivered stays queued, control still ahead of bulk
+            for event in bulk.into_iter().rev() {
+                event_queue.push_front(event);
+            }
+            for event in control.into_iter().rev() {
+                event_queue.push_front(event);
+            }
+        }
+        delivered
+    }
+
+    /// Number of events waiting to be pumped.
+    pub fn pending_count(&self) -> usize {
+        match self.pending_receives.read() {
+            Ok(event_queue) => event_queue.len(),
+            Err(_) => 0,
+        }
+    }
+
     fn is_email_as_username(input: &str) -> bool {
         input.contains('@')
     }
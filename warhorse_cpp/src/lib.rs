@@ -2,9 +2,21 @@ use std::ffi::{c_char, CStr, CString};
 use serde_json::Value;
 use tracing::{error, info};
 use warhorse_client::{WarhorseClient, WarhorseEvent};
-use warhorse_client::warhorse_protocol::*;
+use warhorse_client::warhorse_protocol::{ChatChannel, ChatMessage, Friend, FriendStatus};
 
-struct WarhorseClientImpl(Box<WarhorseClient>);
+struct WarhorseClientImpl {
+    client: Box<WarhorseClient>,
+    // Contiguous payload storage for client_pump_arena; reused every pump
+    // so steady-state pumps do no allocation at all.
+    pump_arena: Vec<u8>,
+    // Subscription bitmask, one bit per WarhorseEventType; events outside
+    // the mask are dropped at pump time before any serialization.
+    event_mask: u32,
+    // When set, events that carry typed records skip the compatibility
+    // JSON entirely and deliver an empty message; consumers read the
+    // binary records instead.
+    binary_payloads: bool,
+}
 
 #[repr(C)]
 pub struct WarhorseClientHandle {
@@ -29,6 +41,86 @@ pub struct WarhorseEventData {
     pub message: *mut c_char,  // Will contain JSON string for complex data
 }
 
+#[repr(C)]
+pub struct WarhorseEventRef {
+    pub event_type: WarhorseEventType,
+    // Offset/length of the JSON payload inside the pump arena. Each payload
+    // is also NUL-terminated in the arena so it can be read as a C string.
+    // This is the compatibility form; typed payloads below avoid the parse.
+    pub message_offset: usize,
+    pub message_len: usize,
+    // Typed payload: offset of a packed record array in the arena and its
+    // record count. Friend events carry WarhorseFriendRecord entries, chat
+    // events one WarhorseChatRecord. Zero count means no typed payload.
+    pub payload_offset: usize,
+    pub payload_count: usize,
+}
+
+// Offset/length of a string inside the pump arena (NUL-terminated).
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct WarhorseStringRef {
+    pub offset: usize,
+    pub len: usize,
+}
+
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub enum WarhorseFriendStatus {
+    Online,
+    Offline,
+    FriendRequestSent,
+    FriendRequestReceived,
+    Blocked,
+}
+
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct WarhorseFriendRecord {
+    pub id: WarhorseStringRef,
+    pub display_name: WarhorseStringRef,
+    pub status: WarhorseFriendStatus,
+}
+
+#[repr(C)]
+#[derive(Clone, Copy, PartialEq)]
+pub enum WarhorseOutboundOpType {
+    RoomMessage,
+    WhisperMessage,
+    FriendRequest,
+    AcceptFriendRequest,
+    RejectFriendRequest,
+    RemoveFriend,
+    BlockUser,
+    UnblockUser,
+}
+
+// One queued outbound operation; string fields reference the batch's
+// contiguous string buffer.
+#[repr(C)]
+pub struct WarhorseOutboundOp {
+    pub op_type: WarhorseOutboundOpType,
+    pub target: WarhorseStringRef,  // room id or friend id
+    pub message: WarhorseStringRef, // chat text; empty for non-chat ops
+}
+
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub enum WarhorseChatChannelType {
+    Room,
+    PrivateMessage,
+}
+
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct WarhorseChatRecord {
+    pub display_name: WarhorseStringRef,
+    pub channel_type: WarhorseChatChannelType,
+    pub channel: WarhorseStringRef,
+    pub message: WarhorseStringRef,
+    pub time: u32,
+}
+
 #[no_mangle]
 pub extern "C" fn use_log() {
     tracing_subscriber::fmt::init();
@@ -36,6 +128,17 @@ pub extern "C" fn use_log() {
 
 #[no_mangle]
 pub extern "C" fn client_new(connection_string: *const c_char) -> *mut WarhorseClientHandle {
+    client_new_with_mask(connection_string, u32::MAX)
+}
+
+// Like client_new, but only events whose bit is set in event_mask
+// (1 << WarhorseEventType) are ever serialized and delivered; the rest are
+// consumed and dropped at pump time, costing nothing per event.
+#[no_mangle]
+pub extern "C" fn client_new_with_mask(
+    connection_string: *const c_char,
+    event_mask: u32,
+) -> *mut WarhorseClientHandle {
     let connection_str = unsafe {
         match CStr::from_ptr(connection_string).to_str() {
             Ok(s) => s,
@@ -45,7 +148,12 @@ pub extern "C" fn client_new(connection_string: *const c_char) -> *mut WarhorseC
 
     match WarhorseClient::new(connection_str) {
         Ok(client) => {
-            let impl_handle = Box::new(WarhorseClientImpl(Box::new(client)));
+            let impl_handle = Box::new(WarhorseClientImpl {
+                client: Box::new(client),
+                pump_arena: Vec::new(),
+                event_mask,
+                binary_payloads: false,
+            });
             Box::into_raw(impl_handle) as *mut WarhorseClientHandle
         }
         Err(_) => std::ptr::null_mut()
@@ -86,13 +194,7 @@ pub extern "C" fn client_login_with_username(
         }
     };
 
-    let login = UserLogin {
-        language: Language::English,
-        identity: LoginUserIdentity::AccountName(username_str.to_string()),
-        password: password_str.to_string(),
-    };
-
-    match handle.0.send_user_login_request(login) {
+    match handle.client.send_user_login_request(username_str.to_string(), password_str.to_string()) {
         Ok(_) => {
             linfo("Attempting to login to Warhorse");
             true
@@ -104,6 +206,161 @@ pub extern "C" fn client_login_with_username(
     }
 }
 
+// Type tag alone, for mask filtering without touching the payload.
+fn event_type_of(event: &WarhorseEvent) -> WarhorseEventType {
+    match event {
+        WarhorseEvent::Hello => WarhorseEventType::Hello,
+        WarhorseEvent::LoggedIn => WarhorseEventType::LoggedIn,
+        WarhorseEvent::Error(_) => WarhorseEventType::Error,
+        WarhorseEvent::FriendRequestReceived(_) => WarhorseEventType::FriendRequests,
+        WarhorseEvent::FriendsList(_) => WarhorseEventType::FriendsList,
+        WarhorseEvent::FriendRequestAccepted(_) => WarhorseEventType::FriendRequestAccepted,
+        WarhorseEvent::ChatMessage(_) => WarhorseEventType::ChatMessage,
+    }
+}
+
+fn event_subscribed(event_mask: u32, event: &WarhorseEvent) -> bool {
+    event_mask & (1u32 << event_type_of(event) as u32) != 0
+}
+
+fn has_typed_payload(event: &WarhorseEvent) -> bool {
+    matches!(
+        event,
+        WarhorseEvent::FriendsList(_)
+            | WarhorseEvent::FriendRequestReceived(_)
+            | WarhorseEvent::FriendRequestAccepted(_)
+            | WarhorseEvent::ChatMessage(_)
+    )
+}
+
+// Enables binary-only payload delivery: events whose data is fully
+// represented by the typed records (friends, chat) stop serializing the
+// compatibility JSON and deliver an empty message. Control events keep
+// their JSON. This removes the serde cost from the pump path; on-the-wire
+// binary framing additionally needs the server to negotiate it at Hello.
+#[no_mangle]
+pub extern "C" fn client_use_binary_payloads(handle: *mut WarhorseClientHandle, enabled: bool) {
+    let handle = unsafe {
+        if handle.is_null() { return; }
+        &mut *(handle as *mut WarhorseClientImpl)
+    };
+    handle.binary_payloads = enabled;
+}
+
+// Maps a client event to its FFI type tag and JSON payload.
+fn event_parts(event: &WarhorseEvent) -> (WarhorseEventType, Result<String, String>) {
+    match event {
+        WarhorseEvent::Hello => {
+            linfo("Received hello event");
+            (WarhorseEventType::Hello, to_json(&Value::Null))
+        }
+        WarhorseEvent::LoggedIn => {
+            linfo("Received logged in event");
+            (WarhorseEventType::LoggedIn, to_json(&Value::Null))
+        }
+        WarhorseEvent::Error(msg) => {
+            linfo("Received error event");
+            (WarhorseEventType::Error, to_json(msg))
+        }
+        WarhorseEvent::FriendRequestReceived(friend) => {
+            linfo("Received friend request event");
+            (WarhorseEventType::FriendRequests, to_json(&[friend]))
+        }
+        WarhorseEvent::FriendsList(friends) => {
+            linfo("Received friends list event");
+            (WarhorseEventType::FriendsList, to_json(friends))
+        }
+        WarhorseEvent::FriendRequestAccepted(friend) => {
+            linfo("Received friend request accepted event");
+            (WarhorseEventType::FriendRequestAccepted, to_json(friend))
+        }
+        WarhorseEvent::ChatMessage(msg) => {
+            linfo("Received chat message event");
+            (WarhorseEventType::ChatMessage, to_json(msg))
+        }
+    }
+}
+
+fn to_friend_status(status: &FriendStatus) -> WarhorseFriendStatus {
+    match status {
+        FriendStatus::Online => WarhorseFriendStatus::Online,
+        FriendStatus::Offline => WarhorseFriendStatus::Offline,
+        FriendStatus::FriendRequestSent => WarhorseFriendStatus::FriendRequestSent,
+        FriendStatus::FriendRequestReceived => WarhorseFriendStatus::FriendRequestReceived,
+        FriendStatus::Blocked => WarhorseFriendStatus::Blocked,
+    }
+}
+
+fn push_arena_str(arena: &mut Vec<u8>, s: &str) -> WarhorseStringRef {
+    let offset = arena.len();
+    arena.extend_from_slice(s.as_bytes());
+    arena.push(0);
+    WarhorseStringRef { offset, len: s.len() }
+}
+
+// Pads the arena so the next write lands on a pointer-aligned offset,
+// which the record structs below require.
+fn align_arena(arena: &mut Vec<u8>) {
+    while arena.len() % std::mem::align_of::<usize>() != 0 {
+        arena.push(0);
+    }
+}
+
+fn push_arena_records<T: Copy>(arena: &mut Vec<u8>, records: &[T], event_ref: &mut WarhorseEventRef) {
+    align_arena(arena);
+    event_ref.payload_offset = arena.len();
+    event_ref.payload_count = records.len();
+    let bytes = unsafe {
+        std::slice::from_raw_parts(
+            records.as_ptr() as *const u8,
+            std::mem::size_of_val(records),
+        )
+    };
+    arena.extend_from_slice(bytes);
+}
+
+fn write_friend_records(arena: &mut Vec<u8>, friends: &[Friend], event_ref: &mut WarhorseEventRef) {
+    let mut records = Vec::with_capacity(friends.len());
+    for friend in friends {
+        records.push(WarhorseFriendRecord {
+            id: push_arena_str(arena, &friend.id),
+            display_name: push_arena_str(arena, &friend.display_name),
+            status: to_friend_status(&friend.status),
+        });
+    }
+    push_arena_records(arena, &records, event_ref);
+}
+
+fn write_chat_record(arena: &mut Vec<u8>, msg: &ChatMessage, event_ref: &mut WarhorseEventRef) {
+    let (channel_type, channel) = match &msg.channel {
+        ChatChannel::Room(room) => (WarhorseChatChannelType::Room, room.as_str()),
+        ChatChannel::PrivateMessage(user) => (WarhorseChatChannelType::PrivateMessage, user.as_str()),
+    };
+    let record = WarhorseChatRecord {
+        display_name: push_arena_str(arena, &msg.display_name),
+        channel_type,
+        channel: push_arena_str(arena, channel),
+        message: push_arena_str(arena, &msg.message),
+        time: msg.time,
+    };
+    push_arena_records(arena, std::slice::from_ref(&record), event_ref);
+}
+
+// Writes the typed payload for an event into the arena, if it has one.
+fn write_typed_payload(arena: &mut Vec<u8>, event: &WarhorseEvent, event_ref: &mut WarhorseEventRef) {
+    event_ref.payload_offset = 0;
+    event_ref.payload_count = 0;
+    match event {
+        WarhorseEvent::FriendsList(friends) => write_friend_records(arena, friends, event_ref),
+        WarhorseEvent::FriendRequestReceived(friend)
+        | WarhorseEvent::FriendRequestAccepted(friend) => {
+            write_friend_records(arena, std::slice::from_ref(friend), event_ref)
+        }
+        WarhorseEvent::ChatMessage(msg) => write_chat_record(arena, msg, event_ref),
+        _ => {}
+    }
+}
+
 #[no_mangle]
 pub extern "C" fn client_pump(
     handle: *mut WarhorseClientHandle,
@@ -115,116 +372,254 @@ pub extern "C" fn client_pump(
         &*(handle as *mut WarhorseClientImpl)
     };
 
-    let rust_events = handle.0.pump();
+    let rust_events = handle.client.pump_limited(max_events);
     let mut count = 0;
 
-    for (i, event) in rust_events.into_iter().take(max_events).enumerate() {
+    for event in rust_events.into_iter() {
+        if !event_subscribed(handle.event_mask, &event) {
+            continue;
+        }
         let event_data = unsafe {
-            &mut *events.add(i)
+            &mut *events.add(count)
         };
 
-        match event {
-            WarhorseEvent::Hello => {
-                linfo("Received hello event");
-                event_data.event_type = WarhorseEventType::Hello;
-                match to_json_as_cstring(&Value::Null) {
-                    Ok(cstr) => event_data.message = cstr.into_raw(),
-                    Err(e) => {
-                        lerror(&format!("Error serializing hello message: {}", e));
-                        event_data.message = std::ptr::null_mut()
-                    },
-                }
+        let (event_type, json) = event_parts(&event);
+        event_data.event_type = event_type;
+        event_data.message = match json.and_then(|s| CString::new(s).map_err(|e| e.to_string())) {
+            Ok(cstr) => cstr.into_raw(),
+            Err(e) => {
+                lerror(&format!("Error serializing event message: {}", e));
+                std::ptr::null_mut()
             }
-            WarhorseEvent::LoggedIn => {
-                linfo("Received logged in event");
-                event_data.event_type = WarhorseEventType::LoggedIn;
-                match to_json_as_cstring(&Value::Null) {
-                    Ok(cstr) => event_data.message = cstr.into_raw(),
-                    Err(e) => {
-                        lerror(&format!("Error serializing logged in message: {}", e));
-                        event_data.message = std::ptr::null_mut()
-                    },
+        };
+        count += 1;
+    }
+    count
+}
+
+#[no_mangle]
+pub extern "C" fn client_pump_arena(
+    handle: *mut WarhorseClientHandle,
+    events: *mut WarhorseEventRef,
+    max_events: usize,
+    arena_out: *mut *const c_char,
+) -> usize {
+    let handle = unsafe {
+        if handle.is_null() { return 0; }
+        &mut *(handle as *mut WarhorseClientImpl)
+    };
+
+    // One arena per pump: length resets, capacity is retained, so after
+    // warm-up the whole batch costs zero allocations on either side.
+    handle.pump_arena.clear();
+
+    let rust_events = handle.client.pump_limited(max_events);
+    let mut count = 0;
+
+    for event in rust_events.into_iter() {
+        if !event_subscribed(handle.event_mask, &event) {
+            continue;
+        }
+        let event_ref = unsafe {
+            &mut *events.add(count)
+        };
+
+        if handle.binary_payloads && has_typed_payload(&event) {
+            event_ref.event_type = event_type_of(&event);
+            let msg = push_arena_str(&mut handle.pump_arena, "");
+            event_ref.message_offset = msg.offset;
+            event_ref.message_len = 0;
+        } else {
+            let (event_type, json) = event_parts(&event);
+            event_ref.event_type = event_type;
+            match json {
+                Ok(s) => {
+                    let msg = push_arena_str(&mut handle.pump_arena, &s);
+                    event_ref.message_offset = msg.offset;
+                    event_ref.message_len = msg.len;
                 }
-            }
-            WarhorseEvent::Error(msg) => {
-                linfo(&format!("Received error event: {:?}", msg).as_str());
-                event_data.event_type = WarhorseEventType::Error;
-                match to_json_as_cstring(&msg) {
-                    Ok(cstr) => event_data.message = cstr.into_raw(),
-                    Err(e) => {
-                        lerror(&format!("Error serializing error message: {}", e));
-                        event_data.message = std::ptr::null_mut()
-                    },
+                Err(e) => {
+                    lerror(&format!("Error serializing event message: {}", e));
+                    let msg = push_arena_str(&mut handle.pump_arena, "");
+                    event_ref.message_offset = msg.offset;
+                    event_ref.message_len = 0;
                 }
             }
-            WarhorseEvent::FriendRequests(friends) => {
-                linfo(&format!("Received friend requests event: {:?}", friends).as_str());
-                event_data.event_type = WarhorseEventType::FriendRequests;
-                match to_json_as_cstring(&friends) {
-                    Ok(cstr) => event_data.message = cstr.into_raw(),
-                    Err(e) => {
-                        lerror(&format!("Error serializing friend requests: {}", e));
-                        event_data.message = std::ptr::null_mut()
-                    },
-                }
+        }
+        write_typed_payload(&mut handle.pump_arena, &event, event_ref);
+        count += 1;
+    }
+
+    unsafe {
+        *arena_out = handle.pump_arena.as_ptr() as *const c_char;
+    }
+    count
+}
+
+#[no_mangle]
+pub extern "C" fn client_send_batch(
+    handle: *mut WarhorseClientHandle,
+    ops: *const WarhorseOutboundOp,
+    op_count: usize,
+    strings: *const c_char,
+    strings_len: usize,
+) -> usize {
+    let handle = unsafe {
+        if handle.is_null() || ops.is_null() { return 0; }
+        &*(handle as *mut WarhorseClientImpl)
+    };
+
+    let ops = unsafe { std::slice::from_raw_parts(ops, op_count) };
+    // A batch whose ops all carry empty strings hands us a null string
+    // table (std::vector::data() on an empty vector), and from_raw_parts
+    // requires a non-null pointer even for a zero-length slice.
+    let strings: &[u8] = if strings.is_null() || strings_len == 0 {
+        &[]
+    } else {
+        unsafe { std::slice::from_raw_parts(strings as *const u8, strings_len) }
+    };
+
+    let resolve = |sref: &WarhorseStringRef| -> Option<&str> {
+        strings
+            .get(sref.offset..sref.offset + sref.len)
+            .and_then(|bytes| std::str::from_utf8(bytes).ok())
+    };
+
+    let mut queued = 0;
+    for op in ops {
+        let Some(target) = resolve(&op.target) else {
+            lerror("Invalid target string in outbound batch");
+            continue;
+        };
+        let result = match op.op_type {
+            WarhorseOutboundOpType::RoomMessage => {
+                let Some(message) = resolve(&op.message) else { continue };
+                handle.client.send_room_message(target.to_string(), message.to_string())
             }
-            WarhorseEvent::FriendsList(friends) => {
-                linfo(&format!("Received friends list event: {:?}", friends).as_str());
-                event_data.event_type = WarhorseEventType::FriendsList;
-                match to_json_as_cstring(&friends) {
-                    Ok(cstr) => event_data.message = cstr.into_raw(),
-                    Err(e) => {
-                        lerror(&format!("Error serializing friends list: {}", e));
-                        event_data.message = std::ptr::null_mut()
-                    },
-                }
+            WarhorseOutboundOpType::WhisperMessage => {
+                let Some(message) = resolve(&op.message) else { continue };
+                handle.client.send_whisper_message(target.to_string(), message.to_string())
             }
-            WarhorseEvent::BlockedList(friends) => {
-                linfo(&format!("Received blocked list event: {:?}", friends).as_str());
-                event_data.event_type = WarhorseEventType::BlockedList;
-                match to_json_as_cstring(&friends) {
-                    Ok(cstr) => event_data.message = cstr.into_raw(),
-                    Err(e) => {
-                        lerror(&format!("Error serializing blocked list: {}", e));
-                        event_data.message = std::ptr::null_mut()
-                    },
-                }
+            WarhorseOutboundOpType::FriendRequest => {
+                handle.client.send_friend_request(target.to_string())
             }
-            WarhorseEvent::FriendRequestAccepted(friend) => {
-                linfo(&format!("Received friend request accepted event: {:?}", friend).as_str());
-                event_data.event_type = WarhorseEventType::FriendRequestAccepted;
-                match to_json_as_cstring(&friend) {
-                    Ok(cstr) => event_data.message = cstr.into_raw(),
-                    Err(e) => {
-                        lerror(&format!("Error serializing friend request accepted: {}", e));
-                        event_data.message = std::ptr::null_mut()
-                    },
-                }
+            WarhorseOutboundOpType::AcceptFriendRequest => {
+                handle.client.send_accept_friend_request(target.to_string())
+            }
+            WarhorseOutboundOpType::RejectFriendRequest => {
+                handle.client.send_reject_friend_request(target.to_string())
+            }
+            WarhorseOutboundOpType::RemoveFriend => {
+                handle.client.send_remove_friend(target.to_string())
+            }
+            WarhorseOutboundOpType::BlockUser => {
+                handle.client.send_block_friend(target.to_string())
+            }
+            WarhorseOutboundOpType::UnblockUser => {
+                handle.client.send_unblock_friend(target.to_string())
             }
-            WarhorseEvent::ChatMessage(msg) => {
-                linfo(&format!("Received chat message event: {:?}", msg).as_str());
-                event_data.event_type = WarhorseEventType::ChatMessage;
-                match to_json_as_cstring(&msg) {
-                    Ok(cstr) => event_data.message = cstr.into_raw(),
-                    Err(e) => {
-                        lerror(&format!("Error serializing chat message: {}", e).as_str());
-                        event_data.message = std::ptr::null_mut()
-                    },
+        };
+        match result {
+            Ok(_) => queued += 1,
+            Err(e) => lerror(&format!("Error queueing outbound op: {}", e)),
+        }
+    }
+    queued
+}
+
+#[no_mangle]
+pub extern "C" fn client_pending_events(handle: *mut WarhorseClientHandle) -> usize {
+    let handle = unsafe {
+        if handle.is_null() { return 0; }
+        &*(handle as *mut WarhorseClientImpl)
+    };
+    handle.client.pending_count()
+}
+
+#[no_mangle]
+pub extern "C" fn client_wait_for_events(
+    handle: *mut WarhorseClientHandle,
+    timeout_ms: u64,
+) -> bool {
+    let handle = unsafe {
+        if handle.is_null() { return false; }
+        &*(handle as *mut WarhorseClientImpl)
+    };
+    handle.client.wait_for_events(std::time::Duration::from_millis(timeout_ms))
+}
+
+#[no_mangle]
+pub extern "C" fn client_pump_arena_prioritized(
+    handle: *mut WarhorseClientHandle,
+    events: *mut WarhorseEventRef,
+    max_events: usize,
+    bulk_budget: usize,
+    drop_oldest: bool,
+    arena_out: *mut *const c_char,
+) -> usize {
+    let handle = unsafe {
+        if handle.is_null() { return 0; }
+        &mut *(handle as *mut WarhorseClientImpl)
+    };
+
+    handle.pump_arena.clear();
+
+    let rust_events = handle.client.pump_prioritized(max_events, bulk_budget, drop_oldest);
+    let mut count = 0;
+
+    for event in rust_events.into_iter() {
+        if !event_subscribed(handle.event_mask, &event) {
+            continue;
+        }
+        let event_ref = unsafe {
+            &mut *events.add(count)
+        };
+
+        if handle.binary_payloads && has_typed_payload(&event) {
+            event_ref.event_type = event_type_of(&event);
+            let msg = push_arena_str(&mut handle.pump_arena, "");
+            event_ref.message_offset = msg.offset;
+            event_ref.message_len = 0;
+        } else {
+            let (event_type, json) = event_parts(&event);
+            event_ref.event_type = event_type;
+            match json {
+                Ok(s) => {
+                    let msg = push_arena_str(&mut handle.pump_arena, &s);
+                    event_ref.message_offset = msg.offset;
+                    event_ref.message_len = msg.len;
+                }
+                Err(e) => {
+                    lerror(&format!("Error serializing event message: {}", e));
+                    let msg = push_arena_str(&mut handle.pump_arena, "");
+                    event_ref.message_offset = msg.offset;
+                    event_ref.message_len = 0;
                 }
             }
         }
+        write_typed_payload(&mut handle.pump_arena, &event, event_ref);
         count += 1;
     }
+
+    unsafe {
+        *arena_out = handle.pump_arena.as_ptr() as *const c_char;
+    }
     count
 }
 
-fn to_json_as_cstring<T: serde::Serialize>(value: &T) -> Result<CString, String> {
-    serde_json::to_string(value)
-        .map_err(|e| e.to_string())
-        .and_then(|json_str| {
-            CString::new(json_str)
-                .map_err(|e| e.to_string())
-        })
+#[no_mangle]
+pub extern "C" fn release_pump_arena(handle: *mut WarhorseClientHandle) {
+    let handle = unsafe {
+        if handle.is_null() { return; }
+        &mut *(handle as *mut WarhorseClientImpl)
+    };
+    // Drops the backing storage; any outstanding WarhorseEventRef offsets
+    // from the last pump are invalid after this call.
+    handle.pump_arena = Vec::new();
+}
+
+fn to_json<T: serde::Serialize>(value: &T) -> Result<String, String> {
+    serde_json::to_string(value).map_err(|e| e.to_string())
 }
 
 fn linfo(message: &str) {
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Bump arena plus a std-style allocator over it, for frame-scoped
+// containers: allocation is a pointer bump, individual deallocation is a
+// no-op, and reset() recycles every block at once. Pair it with the
+// allocator-agnostic pump entry points so the per-frame Message vectors
+// never touch the global heap after warm-up — and so the allocation
+// tracking in ClientStats reads zero for them.
+class ArenaStorage {
+public:
+    explicit ArenaStorage(size_t block_size = 64 * 1024) : block_size(block_size) {}
+
+    void* allocate(size_t bytes, size_t align) {
+        while (current < blocks.size()) {
+            size_t aligned = (offset + align - 1) & ~(align - 1);
+            if (aligned + bytes <= blocks[current].size) {
+                offset = aligned + bytes;
+                return blocks[current].data.get() + aligned;
+            }
+            current++;
+            offset = 0;
+        }
+        size_t size = bytes > block_size ? bytes : block_size;
+        blocks.push_back({std::make_unique<char[]>(size), size});
+        offset = bytes;
+        return blocks.back().data.get();
+    }
+
+    // Invalidates everything handed out; capacity is retained, so a
+    // steady-state frame allocates nothing.
+    void reset() {
+        current = 0;
+        offset = 0;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks;
+    size_t current = 0;
+    size_t offset = 0;
+    size_t block_size;
+};
+
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(ArenaStorage& storage) : storage(&storage) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : storage(other.storage) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(storage->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) {} // memory lives until the arena resets
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return storage == other.storage; }
+
+    ArenaStorage* storage;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
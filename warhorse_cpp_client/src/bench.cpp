@@ -0,0 +1,222 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "arena_alloc.h"
+#include "bench_mock.h"
+#include "client.h"
+
+// Benchmarks the FFI event path against the mock bindings: pump_messages,
+// zero-copy pump_events, and callback dispatch at controlled event rates
+// and payload sizes, reporting events/sec and heap allocations per pump.
+
+static std::atomic<size_t> g_alloc_count{0};
+
+void* operator new(size_t size) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = std::malloc(size);
+    if (ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = std::malloc(size);
+    if (ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+
+struct BenchResult {
+    double events_per_sec;
+    double allocs_per_pump;
+};
+
+template <typename PumpFn>
+static BenchResult run_bench(WarhorseClient& client, size_t iterations, PumpFn&& pump) {
+
+    // Warm up so arena/buffer capacities settle before counting.
+    size_t events_per_pump = 0;
+    for (int i = 0; i < 16; i++) {
+        events_per_pump = pump(client);
+    }
+
+    size_t allocs_before = g_alloc_count.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+
+    size_t total_events = 0;
+    for (size_t i = 0; i < iterations; i++) {
+        total_events += pump(client);
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    size_t allocs = g_alloc_count.load(std::memory_order_relaxed) - allocs_before;
+
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    BenchResult result;
+    result.events_per_sec = seconds > 0.0 ? total_events / seconds : 0.0;
+    result.allocs_per_pump = static_cast<double>(allocs) / iterations;
+    (void)events_per_pump;
+    return result;
+}
+
+static void report(const char* name, const BenchResult& result) {
+    std::printf("%-40s %14.0f ev/s %10.2f allocs/pump\n",
+                name, result.events_per_sec, result.allocs_per_pump);
+}
+
+int main() {
+    constexpr size_t ITERATIONS = 20000;
+
+    WarhorseClient client("mock://bench", 64);
+    client.set_alloc_counter(
+        [] { return static_cast<uint64_t>(g_alloc_count.load(std::memory_order_relaxed)); });
+
+    // Chat stream: 32 events per pump, 256-byte payloads.
+    mock_set_chat_stream(32, 256);
+
+    report("chat 32x256B pump_events (zero-copy)",
+           run_bench(client, ITERATIONS, [](WarhorseClient& c) {
+               std::vector<EventView> views(64);
+               return c.pump_events(views);
+           }));
+
+    report("chat 32x256B pump_messages (copying)",
+           run_bench(client, ITERATIONS, [](WarhorseClient& c) {
+               std::vector<Message> messages;
+               c.pump_messages(messages);
+               return messages.size();
+           }));
+
+    // Arena-backed variant: the Message vector bump-allocates and payloads
+    // this size stay in the MessageText inline buffer, so the client layer's
+    // share of the copying path never touches the global heap (the residue
+    // here is the mock synthesizing one payload string per event).
+    mock_set_chat_stream(32, 64);
+    ArenaStorage message_arena;
+    report("chat 32x64B pump_messages (arena)",
+           run_bench(client, ITERATIONS, [&message_arena](WarhorseClient& c) {
+               message_arena.reset();
+               ArenaVector<Message> messages{ArenaAllocator<Message>(message_arena)};
+               c.pump_messages_into(messages);
+               return messages.size();
+           }));
+    mock_set_chat_stream(32, 256);
+
+    size_t dispatched = 0;
+    client.bind_on_chat_message([&dispatched](const char* message) {
+        (void)message;
+        dispatched++;
+    });
+    report("chat 32x256B dispatch (callback table)",
+           run_bench(client, ITERATIONS, [](WarhorseClient& c) {
+               return c.dispatch();
+           }));
+
+    report("chat 32x256B dispatch_with (static)",
+           run_bench(client, ITERATIONS, [&dispatched](WarhorseClient& c) {
+               return c.dispatch_with([&dispatched](const EventView& event) {
+                   (void)event;
+                   dispatched++;
+               });
+           }));
+
+    // Scatter pump: events land directly in a per-type queue in the same
+    // pass, instead of being re-partitioned from a combined vector.
+    std::vector<Message> chat_queue;
+    client.bind_sink(CHAT_MESSAGE, &chat_queue);
+    report("chat 32x256B pump_scatter (per-type)",
+           run_bench(client, ITERATIONS, [&chat_queue](WarhorseClient& c) {
+               chat_queue.clear();
+               return c.pump_scatter();
+           }));
+    client.bind_sink(CHAT_MESSAGE, nullptr);
+
+    // Large payloads: 8 events per pump, 4 KB each.
+    mock_set_chat_stream(8, 4096);
+    report("chat 8x4KB pump_events (zero-copy)",
+           run_bench(client, ITERATIONS, [](WarhorseClient& c) {
+               std::vector<EventView> views(64);
+               return c.pump_events(views);
+           }));
+
+    // Roster refresh: one 2000-entry friends list per pump (the roster
+    // cache diff runs inside pump_events).
+    mock_set_friends_stream(2000);
+    report("friends list 2000 entries pump_events",
+           run_bench(client, 2000, [](WarhorseClient& c) {
+               std::vector<EventView> views(4);
+               size_t n = c.pump_events(views);
+               return n > 0 ? views[0].friend_count : 0;
+           }));
+
+    // Steady-state interning: 500 distinct sender names seen repeatedly.
+    mock_set_chat_stream(32, 64);
+    std::vector<InternedStr> retained;
+    size_t sender = 0;
+    report("intern 500 senders (steady state)",
+           run_bench(client, ITERATIONS, [&](WarhorseClient& c) {
+               return c.dispatch_with([&](const EventView& event) {
+                   if (event.chat != nullptr) {
+                       std::string name = "sender_" + std::to_string(sender++ % 500);
+                       retained.push_back(c.strings().intern(name));
+                       if (retained.size() > 4096) {
+                           retained.clear();
+                       }
+                   }
+               });
+           }));
+
+    // Structural JSON scan of a 2000-entry roster payload (compatibility
+    // form), pulling three fields per entry through the lazy views.
+    std::string roster_json = "[";
+    for (size_t i = 0; i < 2000; i++) {
+        if (i > 0) roster_json += ",";
+        roster_json += "{\"id\":\"user_" + std::to_string(i) +
+                       "\",\"display_name\":\"Friend " + std::to_string(i) +
+                       "\",\"status\":\"" + (i % 2 == 0 ? "Online" : "Offline") + "\"}";
+    }
+    roster_json += "]";
+
+    size_t fields_seen = 0;
+    report("json scan 2000-entry roster payload",
+           run_bench(client, 2000, [&](WarhorseClient& c) {
+               return c.for_each_json_object(roster_json, [&](const JsonObjectView& obj) {
+                   fields_seen += !obj.field("id").empty();
+                   fields_seen += !obj.field("display_name").empty();
+                   fields_seen += !obj.field("status").empty();
+               });
+           }));
+
+    // CI gate: the zero-copy path must stay allocation-free. The few
+    // allocations per pump seen here come from the mock synthesizing its
+    // payload; a per-event regression in the client layer (32 events/pump)
+    // blows straight past this bound and fails the build.
+    mock_set_chat_stream(32, 256);
+    std::vector<EventView> gate_views(64);
+    BenchResult gate = run_bench(client, 2000, [&gate_views](WarhorseClient& c) {
+        return c.pump_events(gate_views);
+    });
+    constexpr double MAX_ALLOCS_PER_PUMP = 8.0;
+
+    mock_reset();
+    std::printf("dispatched %zu chat callbacks, roster size %zu, pool size %zu, "
+                "json fields %zu, max allocs in one pump %llu\n",
+                dispatched, client.roster().size(), client.strings().size(), fields_seen,
+                static_cast<unsigned long long>(
+                    client.stats().pump_allocs_max.load(std::memory_order_relaxed)));
+
+    if (gate.allocs_per_pump > MAX_ALLOCS_PER_PUMP) {
+        std::printf("FAIL: zero-copy pump allocated %.2f/pump (budget %.0f)\n",
+                    gate.allocs_per_pump, MAX_ALLOCS_PER_PUMP);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,220 @@
+#include "bench_mock.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include "include/bindings.h"
+
+// Mock implementations of the Rust FFI surface. warhorse_bench links these
+// instead of libwarhorse_cpp, so the pump path runs against a synthetic
+// in-process event stream with no network or Rust core involved.
+
+namespace {
+
+enum class MockMode {
+    Idle,
+    Chat,
+    Friends,
+};
+
+MockMode g_mode = MockMode::Idle;
+size_t g_events_per_pump = 0;
+size_t g_payload_bytes = 0;
+size_t g_friend_count = 0;
+
+struct MockClient {
+    std::vector<char> arena;
+};
+
+warhorse::WarhorseStringRef push_str(std::vector<char>& arena, std::string_view s) {
+    warhorse::WarhorseStringRef ref;
+    ref.offset = arena.size();
+    ref.len = s.size();
+    arena.insert(arena.end(), s.begin(), s.end());
+    arena.push_back('\0');
+    return ref;
+}
+
+void align_arena(std::vector<char>& arena) {
+    while (arena.size() % alignof(void*) != 0) {
+        arena.push_back('\0');
+    }
+}
+
+std::string chat_json(size_t payload_bytes) {
+    std::string json = "{\"display_name\":\"bench_user\",\"channel\":{\"Room\":\"general\"},\"message\":\"";
+    json.append(payload_bytes, 'x');
+    json += "\",\"time\":1}";
+    return json;
+}
+
+} // namespace
+
+void mock_set_chat_stream(size_t events_per_pump, size_t payload_bytes) {
+    g_mode = MockMode::Chat;
+    g_events_per_pump = events_per_pump;
+    g_payload_bytes = payload_bytes;
+}
+
+void mock_set_friends_stream(size_t friend_count) {
+    g_mode = MockMode::Friends;
+    g_friend_count = friend_count;
+}
+
+void mock_reset() {
+    g_mode = MockMode::Idle;
+}
+
+namespace warhorse {
+
+extern "C" {
+
+void use_log() {}
+
+WarhorseClientHandle *client_new(const char *connection_string) {
+    (void)connection_string;
+    return reinterpret_cast<WarhorseClientHandle*>(new MockClient());
+}
+
+WarhorseClientHandle *client_new_with_mask(const char *connection_string, uint32_t event_mask) {
+    (void)event_mask; // the mock stream is driven explicitly per scenario
+    return client_new(connection_string);
+}
+
+void client_use_binary_payloads(WarhorseClientHandle *handle, bool enabled) {
+    (void)handle; (void)enabled;
+}
+
+bool client_login_with_username(WarhorseClientHandle *handle,
+                                const char *username,
+                                const char *password) {
+    (void)handle; (void)username; (void)password;
+    return true;
+}
+
+uintptr_t client_pump(WarhorseClientHandle *handle,
+                      WarhorseEventData *events,
+                      uintptr_t max_events) {
+    (void)handle;
+    if (g_mode != MockMode::Chat) {
+        return 0;
+    }
+
+    std::string json = chat_json(g_payload_bytes);
+    uintptr_t count = g_events_per_pump < max_events ? g_events_per_pump : max_events;
+    for (uintptr_t i = 0; i < count; i++) {
+        events[i].event_type = WarhorseEventType::ChatMessage;
+        events[i].message = new char[json.size() + 1];
+        std::memcpy(events[i].message, json.c_str(), json.size() + 1);
+    }
+    return count;
+}
+
+uintptr_t client_pump_arena(WarhorseClientHandle *handle,
+                            WarhorseEventRef *events,
+                            uintptr_t max_events,
+                            const char **arena_out) {
+    MockClient* client = reinterpret_cast<MockClient*>(handle);
+    std::vector<char>& arena = client->arena;
+    arena.clear();
+
+    uintptr_t count = 0;
+    if (g_mode == MockMode::Chat) {
+        std::string json = chat_json(g_payload_bytes);
+        count = g_events_per_pump < max_events ? g_events_per_pump : max_events;
+        for (uintptr_t i = 0; i < count; i++) {
+            events[i].event_type = WarhorseEventType::ChatMessage;
+            WarhorseStringRef msg = push_str(arena, json);
+            events[i].message_offset = msg.offset;
+            events[i].message_len = msg.len;
+
+            WarhorseChatRecord record;
+            record.display_name = push_str(arena, "bench_user");
+            record.channel_type = WarhorseChatChannelType::Room;
+            record.channel = push_str(arena, "general");
+            record.message = push_str(arena, std::string_view(json).substr(0, g_payload_bytes));
+            record.time = 1;
+
+            align_arena(arena);
+            events[i].payload_offset = arena.size();
+            events[i].payload_count = 1;
+            const char* bytes = reinterpret_cast<const char*>(&record);
+            arena.insert(arena.end(), bytes, bytes + sizeof(record));
+        }
+    } else if (g_mode == MockMode::Friends && max_events > 0) {
+        events[0].event_type = WarhorseEventType::FriendsList;
+        WarhorseStringRef msg = push_str(arena, "[]");
+        events[0].message_offset = msg.offset;
+        events[0].message_len = msg.len;
+
+        std::vector<WarhorseFriendRecord> records(g_friend_count);
+        for (size_t i = 0; i < g_friend_count; i++) {
+            std::string id = "user_" + std::to_string(i);
+            records[i].id = push_str(arena, id);
+            records[i].display_name = push_str(arena, "Friend " + std::to_string(i));
+            records[i].status = (i % 2 == 0) ? WarhorseFriendStatus::Online
+                                             : WarhorseFriendStatus::Offline;
+        }
+
+        align_arena(arena);
+        events[0].payload_offset = arena.size();
+        events[0].payload_count = records.size();
+        const char* bytes = reinterpret_cast<const char*>(records.data());
+        arena.insert(arena.end(), bytes, bytes + records.size() * sizeof(WarhorseFriendRecord));
+        count = 1;
+    }
+
+    *arena_out = arena.data();
+    return count;
+}
+
+uintptr_t client_pump_arena_prioritized(WarhorseClientHandle *handle,
+                                        WarhorseEventRef *events,
+                                        uintptr_t max_events,
+                                        uintptr_t bulk_budget,
+                                        bool drop_oldest,
+                                        const char **arena_out) {
+    (void)drop_oldest;
+    // The mock stream has no backlog; the budget just caps the batch.
+    uintptr_t cap = bulk_budget < max_events ? bulk_budget : max_events;
+    return client_pump_arena(handle, events, cap, arena_out);
+}
+
+void release_pump_arena(WarhorseClientHandle *handle) {
+    reinterpret_cast<MockClient*>(handle)->arena = std::vector<char>();
+}
+
+uintptr_t client_pending_events(WarhorseClientHandle *handle) {
+    (void)handle;
+    return 0;
+}
+
+bool client_wait_for_events(WarhorseClientHandle *handle, uint64_t timeout_ms) {
+    (void)handle; (void)timeout_ms;
+    return g_mode != MockMode::Idle;
+}
+
+uintptr_t client_send_batch(WarhorseClientHandle *handle,
+                            const WarhorseOutboundOp *ops,
+                            uintptr_t op_count,
+                            const char *strings,
+                            uintptr_t strings_len) {
+    (void)handle; (void)ops; (void)strings; (void)strings_len;
+    return op_count;
+}
+
+void log_info(const char *message) { (void)message; }
+
+void log_error(const char *message) { (void)message; }
+
+void client_free(WarhorseClientHandle *handle) {
+    delete reinterpret_cast<MockClient*>(handle);
+}
+
+void free_string(char *ptr) {
+    delete[] ptr;
+}
+
+}  // extern "C"
+
+}  // namespace warhorse
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+// Controls the synthetic event stream produced by the mock FFI bindings in
+// bench_mock.cpp, which stand in for the Rust core so the pump path can be
+// benchmarked in-process at controlled rates and payload sizes.
+
+// Every pump delivers events_per_pump chat messages with payloads of
+// payload_bytes characters.
+void mock_set_chat_stream(size_t events_per_pump, size_t payload_bytes);
+
+// Every pump delivers one friends-list event with friend_count entries.
+void mock_set_friends_stream(size_t friend_count);
+
+// Stops producing events.
+void mock_reset();
@@ -0,0 +1,200 @@
+#include "chat_history.h"
+
+#include <cstring>
+#include <filesystem>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// On-disk framing: every record is a fixed header followed by the sender
+// and message bytes. payload_len covers everything after the header, so a
+// scan can skip records without touching their contents.
+namespace {
+
+struct RecordHeader {
+    uint32_t payload_len;
+    uint32_t time;
+    uint16_t sender_len;
+};
+
+constexpr size_t HEADER_SIZE = sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint16_t);
+
+// Top bit of sender_len marks a codec-compressed payload; the low 15 bits
+// always hold the raw sender length.
+constexpr uint16_t COMPRESSED_FLAG = 0x8000;
+constexpr size_t MAX_SENDER_LEN = 0x7fff;
+
+} // namespace
+
+ChatHistoryStore::ChatHistoryStore(const std::string& history_dir, bool compress) {
+    this->history_dir = history_dir;
+    if (compress) {
+        codec = std::make_unique<PayloadCodec>(PayloadCodec::default_dictionary());
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(history_dir, ec);
+}
+
+ChatHistoryStore::~ChatHistoryStore() {
+    for (auto& [_, file] : open_files) {
+        std::fclose(file);
+    }
+}
+
+size_t ChatHistoryStore::append(std::string_view channel, uint32_t time,
+                                std::string_view sender, std::string_view message) {
+
+    if (sender.size() > MAX_SENDER_LEN) {
+        return 0;
+    }
+
+    FILE* file = channel_file(channel);
+    if (file == nullptr) {
+        return 0;
+    }
+
+    const char* payload = nullptr;
+    size_t payload_len = sender.size() + message.size();
+    uint16_t sender_len = static_cast<uint16_t>(sender.size());
+
+    if (codec != nullptr) {
+        compress_scratch.clear();
+        compress_scratch.insert(compress_scratch.end(), sender.begin(), sender.end());
+        compress_scratch.insert(compress_scratch.end(), message.begin(), message.end());
+
+        decompress_scratch.clear(); // reused here as the compressed output
+        size_t stored = codec->compress(
+            std::string_view(compress_scratch.data(), compress_scratch.size()),
+            decompress_scratch);
+        if (stored < payload_len) {
+            payload = decompress_scratch.data();
+            payload_len = stored;
+            sender_len |= COMPRESSED_FLAG;
+        }
+    }
+
+    RecordHeader header;
+    header.payload_len = static_cast<uint32_t>(payload_len);
+    header.time = time;
+    header.sender_len = sender_len;
+
+    bool ok = std::fwrite(&header.payload_len, sizeof(header.payload_len), 1, file) == 1 &&
+              std::fwrite(&header.time, sizeof(header.time), 1, file) == 1 &&
+              std::fwrite(&header.sender_len, sizeof(header.sender_len), 1, file) == 1;
+    if (ok) {
+        if (payload != nullptr) {
+            ok = payload_len == 0 || std::fwrite(payload, payload_len, 1, file) == 1;
+        } else {
+            ok = (sender.empty() || std::fwrite(sender.data(), sender.size(), 1, file) == 1) &&
+                 (message.empty() || std::fwrite(message.data(), message.size(), 1, file) == 1);
+        }
+    }
+    std::fflush(file);
+    return ok ? HEADER_SIZE + payload_len : 0;
+}
+
+size_t ChatHistoryStore::for_each(std::string_view channel,
+                                  const std::function<void(const ChatHistoryRecord&)>& visit) {
+#ifdef _WIN32
+    (void)channel;
+    (void)visit;
+    return 0;
+#else
+    std::string path = channel_path(channel);
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return 0;
+    }
+
+    size_t file_size = static_cast<size_t>(st.st_size);
+    const char* data = static_cast<const char*>(
+        mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0));
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return 0;
+    }
+
+    size_t visited = 0;
+    size_t offset = 0;
+    while (offset + HEADER_SIZE <= file_size) {
+        RecordHeader header;
+        std::memcpy(&header.payload_len, data + offset, sizeof(header.payload_len));
+        std::memcpy(&header.time, data + offset + 4, sizeof(header.time));
+        std::memcpy(&header.sender_len, data + offset + 8, sizeof(header.sender_len));
+        offset += HEADER_SIZE;
+
+        bool compressed = (header.sender_len & COMPRESSED_FLAG) != 0;
+        size_t sender_len = header.sender_len & ~COMPRESSED_FLAG;
+
+        if (offset + header.payload_len > file_size ||
+            (!compressed && sender_len > header.payload_len)) {
+            break; // truncated tail (e.g. torn final write); stop cleanly
+        }
+
+        const char* payload = data + offset;
+        size_t payload_len = header.payload_len;
+        if (compressed) {
+            if (codec == nullptr) {
+                // Compressed record in a store opened without compression;
+                // skip it rather than hand out garbage.
+                offset += header.payload_len;
+                continue;
+            }
+            decompress_scratch.clear();
+            if (!codec->decompress(std::string_view(payload, payload_len),
+                                   decompress_scratch) ||
+                sender_len > decompress_scratch.size()) {
+                break;
+            }
+            payload = decompress_scratch.data();
+            payload_len = decompress_scratch.size();
+        }
+
+        ChatHistoryRecord record;
+        record.time = header.time;
+        record.sender = std::string_view(payload, sender_len);
+        record.message = std::string_view(payload + sender_len, payload_len - sender_len);
+        visit(record);
+        visited++;
+        offset += header.payload_len;
+    }
+
+    munmap(const_cast<char*>(data), file_size);
+    return visited;
+#endif
+}
+
+std::string ChatHistoryStore::channel_path(std::string_view channel) const {
+    // Channel names come off the wire; keep the filename safe.
+    std::string name;
+    name.reserve(channel.size());
+    for (char c : channel) {
+        bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                    (c >= '0' && c <= '9') || c == '-' || c == '_';
+        name.push_back(safe ? c : '_');
+    }
+    return history_dir + "/" + name + ".whchat";
+}
+
+FILE* ChatHistoryStore::channel_file(std::string_view channel) {
+    auto it = open_files.find(std::string(channel));
+    if (it != open_files.end()) {
+        return it->second;
+    }
+
+    FILE* file = std::fopen(channel_path(channel).c_str(), "ab");
+    if (file != nullptr) {
+        open_files.emplace(std::string(channel), file);
+    }
+    return file;
+}
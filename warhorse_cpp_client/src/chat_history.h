@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "compress.h"
+
+// One stored chat message. The views alias the channel file's memory
+// mapping and are only valid inside the for_each visit callback.
+struct ChatHistoryRecord {
+    uint32_t time;
+    std::string_view sender;
+    std::string_view message;
+};
+
+// Append-only, memory-mapped chat history, one file per channel. Records
+// use a fixed framing (length-prefixed header + raw bytes), so a warm
+// channel open is an mmap plus a pointer walk: no deserialization and no
+// server round trip. The CHAT_MESSAGE pump path appends as messages
+// arrive; readers scan with for_each.
+//
+// With compression enabled, record payloads go through a dictionary-primed
+// LZ codec (see PayloadCodec) before hitting disk — usernames and message
+// shapes repeat heavily, so history files shrink severalfold — and records
+// that would not shrink are stored raw. Compressed and raw records mix
+// freely in one file; readers decompress per record into a reused scratch
+// buffer.
+//
+// The mapped scan is POSIX-only for now; on Windows for_each reports no
+// history and the store degrades to append-only.
+class ChatHistoryStore {
+public:
+    ChatHistoryStore(const std::string& history_dir, bool compress = false);
+    ~ChatHistoryStore();
+    ChatHistoryStore(const ChatHistoryStore&) = delete;
+    ChatHistoryStore& operator=(const ChatHistoryStore&) = delete;
+
+    // Appends one message to the channel's file. Cheap: one buffered write
+    // through a cached per-channel handle. Returns the stored size in
+    // bytes (header included), or 0 on failure.
+    size_t append(std::string_view channel, uint32_t time,
+                  std::string_view sender, std::string_view message);
+
+    // Maps the channel's file and walks every record in append order.
+    // Returns the number of records visited (0 if there is no history).
+    size_t for_each(std::string_view channel,
+                    const std::function<void(const ChatHistoryRecord&)>& visit);
+
+private:
+    std::string channel_path(std::string_view channel) const;
+    FILE* channel_file(std::string_view channel);
+
+    std::string history_dir;
+    std::unordered_map<std::string, FILE*> open_files;
+
+    // Present only when compression is on; scratch buffers are reused
+    // across appends and scans.
+    std::unique_ptr<PayloadCodec> codec;
+    std::vector<char> compress_scratch;
+    std::vector<char> decompress_scratch;
+};
@@ -1,90 +1,669 @@
 #include "client.h"
 
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include <thread>
 
-WarhorseClient::WarhorseClient(const std::string& connection_string) {
+MessageText::MessageText() {
+    inline_buf[0] = '\0';
+    heap = nullptr;
+    length = 0;
+}
+
+MessageText::MessageText(std::string_view text) : MessageText() {
+    assign(text);
+}
+
+MessageText::MessageText(MessageText&& other) noexcept : MessageText() {
+    *this = std::move(other);
+}
+
+MessageText& MessageText::operator=(MessageText&& other) noexcept {
+    if (this != &other) {
+        release();
+        if (other.heap != nullptr) {
+            heap = other.heap;
+        } else {
+            std::memcpy(inline_buf, other.inline_buf, other.length + 1);
+        }
+        length = other.length;
+        other.heap = nullptr;
+        other.length = 0;
+        other.inline_buf[0] = '\0';
+    }
+    return *this;
+}
+
+MessageText& MessageText::operator=(std::string_view text) {
+    assign(text);
+    return *this;
+}
+
+MessageText::~MessageText() {
+    release();
+}
+
+void MessageText::assign(std::string_view text) {
+    release();
+    char* dest = inline_buf;
+    if (text.size() > INLINE_CAPACITY) {
+        heap = new char[text.size() + 1];
+        dest = heap;
+    }
+    std::memcpy(dest, text.data(), text.size());
+    dest[text.size()] = '\0';
+    length = text.size();
+}
+
+void MessageText::release() {
+    delete[] heap;
+    heap = nullptr;
+    length = 0;
+    inline_buf[0] = '\0';
+}
+
+static MessageType to_message_type(warhorse::WarhorseEventType event_type) {
+    switch (event_type) {
+        case warhorse::WarhorseEventType::Hello:                 return HELLO;
+        case warhorse::WarhorseEventType::LoggedIn:              return LOGGED_IN;
+        case warhorse::WarhorseEventType::Error:                 return ERROR;
+        case warhorse::WarhorseEventType::FriendRequests:        return FRIEND_REQUESTS;
+        case warhorse::WarhorseEventType::FriendsList:           return FRIENDS_LIST;
+        case warhorse::WarhorseEventType::BlockedList:           return BLOCKED_LIST;
+        case warhorse::WarhorseEventType::FriendRequestAccepted: return FRIEND_REQUEST_ACCEPTED;
+        case warhorse::WarhorseEventType::ChatMessage:           return CHAT_MESSAGE;
+    }
+    return ERROR;
+}
+
+void OutboundBatch::room_message(std::string_view room, std::string_view message) {
+    add(warhorse::WarhorseOutboundOpType::RoomMessage, room, message);
+}
+
+void OutboundBatch::whisper(std::string_view friend_id, std::string_view message) {
+    add(warhorse::WarhorseOutboundOpType::WhisperMessage, friend_id, message);
+}
+
+void OutboundBatch::friend_request(std::string_view friend_id) {
+    add(warhorse::WarhorseOutboundOpType::FriendRequest, friend_id, std::string_view());
+}
+
+void OutboundBatch::accept_friend_request(std::string_view friend_id) {
+    add(warhorse::WarhorseOutboundOpType::AcceptFriendRequest, friend_id, std::string_view());
+}
+
+void OutboundBatch::reject_friend_request(std::string_view friend_id) {
+    add(warhorse::WarhorseOutboundOpType::RejectFriendRequest, friend_id, std::string_view());
+}
+
+void OutboundBatch::remove_friend(std::string_view friend_id) {
+    add(warhorse::WarhorseOutboundOpType::RemoveFriend, friend_id, std::string_view());
+}
+
+void OutboundBatch::block_user(std::string_view user_id) {
+    add(warhorse::WarhorseOutboundOpType::BlockUser, user_id, std::string_view());
+}
+
+void OutboundBatch::unblock_user(std::string_view user_id) {
+    add(warhorse::WarhorseOutboundOpType::UnblockUser, user_id, std::string_view());
+}
+
+void OutboundBatch::clear() {
+    ops.clear();
+    strings.clear();
+}
+
+void OutboundBatch::add(warhorse::WarhorseOutboundOpType op_type, std::string_view target, std::string_view message) {
+
+    // Chat carries unique payloads, but the other ops are idempotent per
+    // target — a duplicate in the same batch would just be wasted writes.
+    if (op_type != warhorse::WarhorseOutboundOpType::RoomMessage &&
+        op_type != warhorse::WarhorseOutboundOpType::WhisperMessage) {
+        for (const warhorse::WarhorseOutboundOp& op : ops) {
+            if (op.op_type == op_type && resolve(op.target) == target) {
+                return;
+            }
+        }
+    }
+
+    warhorse::WarhorseOutboundOp op;
+    op.op_type = op_type;
+    op.target = push_str(target);
+    op.message = push_str(message);
+    ops.push_back(op);
+}
+
+warhorse::WarhorseStringRef OutboundBatch::push_str(std::string_view s) {
+    warhorse::WarhorseStringRef ref;
+    ref.offset = strings.size();
+    ref.len = s.size();
+    strings.insert(strings.end(), s.begin(), s.end());
+    return ref;
+}
+
+std::string_view OutboundBatch::resolve(const warhorse::WarhorseStringRef& ref) const {
+    return std::string_view(strings.data() + ref.offset, ref.len);
+}
+
+WarhorseClient::WarhorseClient(const std::string& connection_string, size_t pump_batch_size)
+    : WarhorseClient(connection_string, pump_batch_size, EVENT_MASK_ALL) {}
+
+void WarhorseClient::init(size_t pump_batch_size) {
 
     // State
     logged_in = false;
     received_hello = false;
     sent_login_request = false;
+    handle = nullptr;
+    connect_done = false;
+    deferred_binary = false;
+
+    // Callbacks and scatter sinks
+    callbacks.fill(nullptr);
+    sinks.fill(nullptr);
+    alloc_counter = nullptr;
+
+    // Pump scratch buffers
+    this->pump_batch_size = pump_batch_size > 0 ? pump_batch_size : 1;
+    event_refs.resize(this->pump_batch_size);
+    event_views.resize(this->pump_batch_size);
+    carry_begin = 0;
+    carry_count = 0;
+
+    // Pump thread
+    ring.resize(RING_CAPACITY);
+    ring_head = 0;
+    ring_tail = 0;
+    pump_thread_running = false;
+}
 
-    // Callbacks
-    on_hello = nullptr;
-    on_logged_in = nullptr;
-    on_error = nullptr;
-    on_friend_requests = nullptr;
-    on_friends_list = nullptr;
-    on_blocked_list = nullptr;
-    on_friend_request_accepted = nullptr;
-    on_chat_message = nullptr;
+WarhorseClient::WarhorseClient(const std::string& connection_string, size_t pump_batch_size,
+                               uint32_t event_mask) {
+    init(pump_batch_size);
+    handle = warhorse::client_new_with_mask(connection_string.c_str(), event_mask);
+    connect_done.store(true, std::memory_order_release);
+}
 
-    handle = warhorse::client_new(connection_string.c_str());
+WarhorseClient::WarhorseClient(DeferConnect, const std::string& connection_string,
+                               size_t pump_batch_size, uint32_t event_mask) {
+    init(pump_batch_size);
+
+    // The construction the caller paid for is done; DNS and TCP happen
+    // here, off the boot path. Anything parked while connecting (login,
+    // binary mode) is applied under the same lock that publishes the
+    // handle, so nothing ordered before the flip is lost.
+    connect_thread = std::thread([this, connection_string, event_mask] {
+        warhorse::WarhorseClientHandle* new_handle =
+            warhorse::client_new_with_mask(connection_string.c_str(), event_mask);
+
+        std::lock_guard<std::mutex> lock(connect_mutex);
+        handle = new_handle;
+        if (deferred_binary) {
+            warhorse::client_use_binary_payloads(handle, true);
+        }
+        if (!deferred_username.empty()) {
+            if (warhorse::client_login_with_username(handle, deferred_username.c_str(),
+                                                     deferred_password.c_str())) {
+                ThreadPolicy::store(sent_login_request, true);
+            }
+            deferred_username.clear();
+            deferred_password.clear();
+        }
+        connect_done.store(true, std::memory_order_release);
+    });
+}
+
+WarhorseClient::WarhorseClient(const std::string& connection_string, const std::string& resume_blob,
+                               size_t pump_batch_size)
+    : WarhorseClient(connection_string, pump_batch_size) {
+
+    // Blob layout (version 1): "WHRS1\n" + username + "\n" + password.
+    // Anything that doesn't parse leaves this a cold client.
+    constexpr std::string_view MAGIC = "WHRS1\n";
+    if (resume_blob.compare(0, MAGIC.size(), MAGIC) != 0) {
+        return;
+    }
+
+    size_t sep = resume_blob.find('\n', MAGIC.size());
+    if (sep == std::string::npos) {
+        return;
+    }
+
+    // Pipelined straight behind the connection setup, same as login_async:
+    // the Rust core queues the request, so LOGGED_IN comes back one round
+    // trip after the transport is up — no Hello wait in between.
+    login(resume_blob.substr(MAGIC.size(), sep - MAGIC.size()), resume_blob.substr(sep + 1));
+}
+
+std::string WarhorseClient::export_resume_blob() const {
+    if (!ThreadPolicy::load(logged_in)) {
+        return std::string();
+    }
+    return "WHRS1\n" + resume_username + "\n" + resume_password;
 }
 
 WarhorseClient::~WarhorseClient() {
-    warhorse::client_free(handle);
+    if (connect_thread.joinable()) {
+        connect_thread.join();
+    }
+    stop_pump_thread();
+    if (handle != nullptr) {
+        warhorse::release_pump_arena(handle);
+        warhorse::client_free(handle);
+    }
 }
 
 bool WarhorseClient::login(const std::string& username, const std::string& password) {
 
+    if (!connected()) {
+        // Connection still coming up in the background: park the
+        // credentials and let the connect thread pipeline the login the
+        // moment the transport exists.
+        std::lock_guard<std::mutex> lock(connect_mutex);
+        if (handle == nullptr) {
+            deferred_username = username;
+            deferred_password = password;
+            resume_username = username;
+            resume_password = password;
+            return true;
+        }
+    }
+
     if (warhorse::client_login_with_username(handle, username.c_str(), password.c_str()))
     {
-        sent_login_request = true;
+        ThreadPolicy::store(sent_login_request, true);
+        resume_username = username;
+        resume_password = password;
         return true;
     }
 
     return false;
 }
 
+size_t WarhorseClient::send_batch(OutboundBatch& batch) {
+    warhorse::WarhorseClientHandle* h = live_handle();
+    if (h == nullptr) {
+        // Still connecting: leave the batch intact so the caller can flush
+        // it once connected() flips.
+        return 0;
+    }
+    size_t queued = warhorse::client_send_batch(h, batch.ops.data(), batch.ops.size(),
+                                                batch.strings.data(), batch.strings.size());
+    batch.clear();
+    return queued;
+}
+
+std::future<LoginResult> WarhorseClient::login_async(const std::string& username, const std::string& password) {
+    std::lock_guard<ThreadPolicy::Mutex> lock(login_mutex);
+    login_promise = std::make_unique<std::promise<LoginResult>>();
+    std::future<LoginResult> future = login_promise->get_future();
+
+    if (!login(username, password)) {
+        login_promise->set_value({ false, "failed to queue login request" });
+        login_promise.reset();
+    }
+
+    return future;
+}
+
 bool WarhorseClient::pump_messages(std::vector<Message>& messages) {
+    return pump_messages_into(messages);
+}
+
+size_t WarhorseClient::pump_messages_until(std::vector<Message>& messages,
+                                           std::chrono::steady_clock::time_point deadline) {
+
+    // Fetch a fresh batch only once the carried remainder is drained; the
+    // conversion below then walks views that alias the still-valid arena.
+    if (carry_begin >= carry_count) {
+        carry_count = pump_events(event_views);
+        carry_begin = 0;
+    }
+
+    size_t converted = 0;
+    while (carry_begin < carry_count) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+        messages.emplace_back(event_views[carry_begin].type, event_views[carry_begin].message);
+        carry_begin++;
+        converted++;
+    }
+    return converted;
+}
+
+size_t WarhorseClient::pump_scatter() {
+    size_t event_count = pump_events(event_views);
+    size_t routed = 0;
+    for (size_t i = 0; i < event_count; i++) {
+        std::vector<Message>* sink = sinks[event_views[i].type];
+        if (sink != nullptr) {
+            sink->emplace_back(event_views[i].type, event_views[i].message);
+            routed++;
+        }
+    }
+    return routed;
+}
+
+size_t WarhorseClient::drain_all(std::vector<Message>& messages) {
+    size_t total = 0;
+    while (pump_messages(messages)) {
+        total = messages.size();
+        if (pending_events() == 0) {
+            break;
+        }
+    }
+    return total;
+}
+
+size_t WarhorseClient::pending_events() const {
+    warhorse::WarhorseClientHandle* h = live_handle();
+    return h != nullptr ? warhorse::client_pending_events(h) : 0;
+}
+
+void WarhorseClient::reset_for_reuse() {
+    stop_pump_thread();
+
+    // Throw away anything queued for the previous owner, on both sides of
+    // the FFI, without running the conversion path (no roster or stats
+    // updates for events nobody will see).
+    warhorse::WarhorseClientHandle* h = live_handle();
+    const char* arena = nullptr;
+    while (h != nullptr &&
+           warhorse::client_pump_arena(h, event_refs.data(), pump_batch_size, &arena) > 0) {
+    }
+    ring_head.store(ring_tail.load(std::memory_order_acquire), std::memory_order_release);
+
+    callbacks.fill(nullptr);
+    sinks.fill(nullptr);
+    presence_callback = nullptr;
+    roster_cache = RosterCache();
+    carry_begin = 0;
+    carry_count = 0;
+
+    {
+        std::lock_guard<ThreadPolicy::Mutex> lock(login_mutex);
+        if (login_promise != nullptr) {
+            login_promise->set_value({ false, "client reset for reuse" });
+            login_promise.reset();
+        }
+    }
+
+    ThreadPolicy::store(logged_in, false);
+    ThreadPolicy::store(sent_login_request, false);
+    resume_username.clear();
+    resume_password.clear();
+}
+
+void WarhorseClient::use_binary_payloads(bool enabled) {
+    if (!connected()) {
+        std::lock_guard<std::mutex> lock(connect_mutex);
+        if (handle == nullptr) {
+            deferred_binary = enabled;
+            return;
+        }
+    }
+    warhorse::client_use_binary_payloads(handle, enabled);
+}
+
+void WarhorseClient::enable_chat_history(const std::string& history_dir, bool compress) {
+    history_store = std::make_unique<ChatHistoryStore>(history_dir, compress);
+}
+
+void WarhorseClient::enable_roster_snapshot(const std::string& snapshot_path) {
+    roster_snapshot_path = snapshot_path;
+    roster_cache.load_snapshot(snapshot_path);
+}
+
+size_t WarhorseClient::pump_events(std::span<EventView> out_events) {
+
+    warhorse::WarhorseClientHandle* h = live_handle();
+    if (h == nullptr) {
+        return 0; // still connecting; local caches carry the UI until then
+    }
 
-    constexpr size_t MAX_EVENTS = 32;
-    warhorse::WarhorseEventData events[MAX_EVENTS];
+    auto pump_start = std::chrono::steady_clock::now();
+    const char* arena = nullptr;
+
+    // The arena is rewritten in place by each pump, so the views handed out
+    // by the previous pump die here.
+    size_t max_events = out_events.size() < pump_batch_size ? out_events.size() : pump_batch_size;
+    size_t event_count = warhorse::client_pump_arena(h, event_refs.data(), max_events, &arena);
+
+    return finish_pump(event_count, arena, out_events, pump_start);
+}
+
+size_t WarhorseClient::pump_events_prioritized(std::span<EventView> out_events,
+                                               size_t bulk_budget, bool drop_oldest) {
+
+    warhorse::WarhorseClientHandle* h = live_handle();
+    if (h == nullptr) {
+        return 0;
+    }
 
-    size_t event_count = warhorse::client_pump(handle, events, MAX_EVENTS);
+    auto pump_start = std::chrono::steady_clock::now();
+    const char* arena = nullptr;
+
+    size_t max_events = out_events.size() < pump_batch_size ? out_events.size() : pump_batch_size;
+    size_t event_count = warhorse::client_pump_arena_prioritized(
+        h, event_refs.data(), max_events, bulk_budget, drop_oldest, &arena);
+
+    return finish_pump(event_count, arena, out_events, pump_start);
+}
+
+size_t WarhorseClient::finish_pump(size_t event_count, const char* arena,
+                                   std::span<EventView> out_events,
+                                   std::chrono::steady_clock::time_point pump_start) {
+
+    warhorse::WarhorseEventRef* events = event_refs.data();
+
+    uint64_t allocs_before = alloc_counter != nullptr ? alloc_counter() : 0;
+
+    uint64_t payload_bytes = 0;
     for (size_t i = 0; i < event_count; i++) {
-        Message message;
-        switch (events[i].event_type) {
-            case warhorse::WarhorseEventType::Hello:
-                message.type = HELLO;
+        out_events[i].type = to_message_type(events[i].event_type);
+        switch (out_events[i].type) {
+            case HELLO:
+                ThreadPolicy::store(received_hello, true);
                 break;
-            case warhorse::WarhorseEventType::LoggedIn:
-                message.type = LOGGED_IN;
-                logged_in = true;
+            case LOGGED_IN: {
+                ThreadPolicy::store(logged_in, true);
+                std::lock_guard<ThreadPolicy::Mutex> lock(login_mutex);
+                if (login_promise != nullptr) {
+                    login_promise->set_value({ true, std::string() });
+                    login_promise.reset();
+                }
                 break;
-            case warhorse::WarhorseEventType::Error:
-                message.type = ERROR;
+            }
+            case ERROR: {
+                std::lock_guard<ThreadPolicy::Mutex> lock(login_mutex);
+                if (login_promise != nullptr && !ThreadPolicy::load(logged_in)) {
+                    login_promise->set_value({ false, std::string(arena + events[i].message_offset,
+                                                                  events[i].message_len) });
+                    login_promise.reset();
+                }
                 break;
-            case warhorse::WarhorseEventType::FriendRequests:
-                message.type = FRIEND_REQUESTS;
+            }
+            default:
                 break;
-            case warhorse::WarhorseEventType::FriendsList:
-                message.type = FRIENDS_LIST;
+        }
+
+        out_events[i].message = std::string_view(arena + events[i].message_offset,
+                                                 events[i].message_len);
+
+        client_stats.event_counts[out_events[i].type].fetch_add(1, std::memory_order_relaxed);
+        payload_bytes += events[i].message_len;
+
+        out_events[i].arena = arena;
+        out_events[i].friends = nullptr;
+        out_events[i].friend_count = 0;
+        out_events[i].chat = nullptr;
+        if (events[i].payload_count > 0) {
+            const char* payload = arena + events[i].payload_offset;
+            if (out_events[i].type == CHAT_MESSAGE) {
+                out_events[i].chat = reinterpret_cast<const warhorse::WarhorseChatRecord*>(payload);
+            } else {
+                out_events[i].friends = reinterpret_cast<const warhorse::WarhorseFriendRecord*>(payload);
+                out_events[i].friend_count = events[i].payload_count;
+            }
+        }
+
+        // Keep the roster cache current as friend events flow through. Only
+        // the friends list is authoritative for removals; the other events
+        // just upsert the records they carry.
+        switch (out_events[i].type) {
+            case FRIENDS_LIST:
+                roster_cache.apply_list(out_events[i].friends, out_events[i].friend_count, arena);
+                if (!roster_snapshot_path.empty()) {
+                    roster_cache.save_snapshot(roster_snapshot_path);
+                }
                 break;
-            case warhorse::WarhorseEventType::BlockedList:
-                message.type = BLOCKED_LIST;
+            case BLOCKED_LIST:
+            case FRIEND_REQUESTS:
+            case FRIEND_REQUEST_ACCEPTED:
+                for (size_t r = 0; r < out_events[i].friend_count; r++) {
+                    roster_cache.apply_update(out_events[i].friends[r], arena);
+                }
                 break;
-            case warhorse::WarhorseEventType::FriendRequestAccepted:
-                message.type = FRIEND_REQUEST_ACCEPTED;
+            case CHAT_MESSAGE:
+                if (history_store != nullptr && out_events[i].chat != nullptr) {
+                    const warhorse::WarhorseChatRecord& chat = *out_events[i].chat;
+                    size_t stored = history_store->append(out_events[i].str(chat.channel),
+                                                          chat.time,
+                                                          out_events[i].str(chat.display_name),
+                                                          out_events[i].str(chat.message));
+                    if (stored > 0) {
+                        client_stats.history_raw_bytes.fetch_add(
+                            chat.display_name.len + chat.message.len,
+                            std::memory_order_relaxed);
+                        client_stats.history_stored_bytes.fetch_add(
+                            stored, std::memory_order_relaxed);
+                    }
+                }
                 break;
-            case warhorse::WarhorseEventType::ChatMessage:
-                message.type = CHAT_MESSAGE;
+            default:
                 break;
         }
+    }
+
+    // One coalesced presence notification per pump, however many friend
+    // events the batch carried.
+    if (presence_callback != nullptr && roster_cache.has_dirty()) {
+        dirty_scratch.clear();
+        roster_cache.collect_dirty(dirty_scratch);
+        presence_callback(dirty_scratch);
+    }
+
+    if (alloc_counter != nullptr) {
+        uint64_t allocs = alloc_counter() - allocs_before;
+        client_stats.pump_allocs.fetch_add(allocs, std::memory_order_relaxed);
+        ClientStats::update_max(client_stats.pump_allocs_max, allocs);
+    }
+
+    auto pump_elapsed = std::chrono::steady_clock::now() - pump_start;
+    uint64_t pump_us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(pump_elapsed).count());
+    size_t bucket = std::bit_width(pump_us);
+    if (bucket >= ClientStats::LATENCY_BUCKETS) {
+        bucket = ClientStats::LATENCY_BUCKETS - 1;
+    }
+    client_stats.pump_latency_us[bucket].fetch_add(1, std::memory_order_relaxed);
+    client_stats.pumps.fetch_add(1, std::memory_order_relaxed);
+    client_stats.events_total.fetch_add(event_count, std::memory_order_relaxed);
+    client_stats.payload_bytes.fetch_add(payload_bytes, std::memory_order_relaxed);
+    ClientStats::update_max(client_stats.batch_high_water, event_count);
+
+    return event_count;
+}
+
+bool WarhorseClient::wait_for_events(std::chrono::milliseconds timeout) {
+    warhorse::WarhorseClientHandle* h = live_handle();
+    if (h == nullptr) {
+        // Behave like a timed-out wait so pump loops back off instead of
+        // spinning while the connection comes up.
+        std::this_thread::sleep_for(timeout);
+        return false;
+    }
+    return warhorse::client_wait_for_events(h, static_cast<uint64_t>(timeout.count()));
+}
+
+size_t WarhorseClient::dispatch() {
+    size_t event_count = pump_events(event_views);
+    for (size_t i = 0; i < event_count; i++) {
+        const WarhorseCallback& callback = callbacks[event_views[i].type];
+        if (callback) {
+            // Arena payloads are NUL-terminated, so the view's data is a
+            // valid C string without copying.
+            callback(event_views[i].message.data());
+        }
+    }
+    return event_count;
+}
+
+void WarhorseClient::start_pump_thread() {
+    if (pump_thread_running.load(std::memory_order_relaxed)) {
+        return;
+    }
+    pump_thread_running.store(true, std::memory_order_relaxed);
+    pump_thread = std::thread(&WarhorseClient::pump_thread_main, this);
+}
+
+void WarhorseClient::stop_pump_thread() {
+    pump_thread_running.store(false, std::memory_order_relaxed);
+    if (pump_thread.joinable()) {
+        pump_thread.join();
+    }
+}
 
-        message.message = events[i].message;
-        messages.push_back(message);
+bool WarhorseClient::try_dequeue(Message& out_message) {
+    size_t head = ring_head.load(std::memory_order_relaxed);
+    if (head == ring_tail.load(std::memory_order_acquire)) {
+        return false;
     }
+    out_message = std::move(ring[head & (RING_CAPACITY - 1)]);
+    ring_head.store(head + 1, std::memory_order_release);
+    return true;
+}
 
-    return event_count > 0;
+bool WarhorseClient::try_enqueue(Message&& message) {
+    size_t tail = ring_tail.load(std::memory_order_relaxed);
+    size_t depth = tail - ring_head.load(std::memory_order_acquire);
+    if (depth >= RING_CAPACITY) {
+        return false;
+    }
+    ring[tail & (RING_CAPACITY - 1)] = std::move(message);
+    ring_tail.store(tail + 1, std::memory_order_release);
+    ClientStats::update_max(client_stats.ring_depth_high_water, depth + 1);
+    return true;
+}
+
+void WarhorseClient::pump_thread_main() {
+    while (pump_thread_running.load(std::memory_order_relaxed)) {
+        wait_for_events(std::chrono::milliseconds(50));
+
+        size_t event_count = pump_events(event_views);
+        for (size_t i = 0; i < event_count; i++) {
+            Message message(event_views[i].type, event_views[i].message);
+
+            // The arena dies on the next pump, so the payload has to cross
+            // the ring by value; back off if the consumer is behind.
+            while (!try_enqueue(std::move(message))) {
+                if (!pump_thread_running.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                std::this_thread::yield();
+            }
+        }
+    }
 }
 
 bool WarhorseClient::is_ready_for_login() const {
-    return received_hello && !sent_login_request;
+    return ThreadPolicy::load(received_hello) && !ThreadPolicy::load(sent_login_request);
 }
 
+#ifndef WARHORSE_NO_MAIN
+
 int test_warhorse_client() {
     warhorse::use_log();
 
@@ -132,39 +711,11 @@ int test_warhorse_client() {
         if (client->is_ready_for_login()) {
         }
 
-        std::vector<Message> messages;
-        if (client->pump_messages(messages)) {
-            for (const auto& message : messages) {
-                switch (message.type) {
-                    case HELLO:
-                        if (client->on_hello) client->on_hello(message.message.c_str());
-                        break;
-                    case LOGGED_IN:
-                        if (client->on_logged_in) client->on_logged_in(message.message.c_str());
-                        break;
-                    case ERROR:
-                        if (client->on_error) client->on_error(message.message.c_str());
-                        break;
-                    case FRIEND_REQUESTS:
-                        if (client->on_friend_requests) client->on_friend_requests(message.message.c_str());
-                        break;
-                    case FRIENDS_LIST:
-                        if (client->on_friends_list) client->on_friends_list(message.message.c_str());
-                        break;
-                    case BLOCKED_LIST:
-                        if (client->on_blocked_list) client->on_blocked_list(message.message.c_str());
-                        break;
-                    case FRIEND_REQUEST_ACCEPTED:
-                        if (client->on_friend_request_accepted) client->on_friend_request_accepted(message.message.c_str());
-                        break;
-                    case CHAT_MESSAGE:
-                        if (client->on_chat_message) client->on_chat_message(message.message.c_str());
-                        break;
-                }
-            }
-        }
+        client->dispatch();
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        // Sleep until the Rust side queues an event instead of polling;
+        // the timeout just keeps the loop responsive to the exit flag.
+        client->wait_for_events(std::chrono::milliseconds(250));
     }
 
     return 0;
@@ -173,3 +724,5 @@ int test_warhorse_client() {
 int main() {
     return test_warhorse_client();
 }
+
+#endif // WARHORSE_NO_MAIN
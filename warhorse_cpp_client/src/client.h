@@ -1,9 +1,23 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <span>
+#include <thread>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
 #include "include/bindings.h"
+#include "chat_history.h"
+#include "intern.h"
+#include "json_scan.h"
+#include "roster.h"
 
 enum MessageType {
     HELLO,
@@ -13,48 +27,522 @@ enum MessageType {
     FRIENDS_LIST,
     BLOCKED_LIST,
     FRIEND_REQUEST_ACCEPTED,
-    CHAT_MESSAGE
+    CHAT_MESSAGE,
+
+    MESSAGE_TYPE_COUNT
+};
+
+// Compile-time event subscription masks. A build that never consumes an
+// event type constructs its clients with a mask excluding it: suppressed
+// events are filtered on the Rust side before serialization (via
+// client_new_with_mask), and dispatch_subscribed drops their handler
+// branches at compile time.
+constexpr uint32_t event_bit(MessageType type) { return 1u << type; }
+
+constexpr uint32_t EVENT_MASK_ALL = (1u << MESSAGE_TYPE_COUNT) - 1;
+
+// What a headless/dedicated-server build keeps: the login state machine
+// plus chat, none of the roster-UI traffic.
+constexpr uint32_t EVENT_MASK_SERVER =
+    event_bit(HELLO) | event_bit(LOGGED_IN) | event_bit(ERROR) | event_bit(CHAT_MESSAGE);
+
+// Move-only payload storage for Message. Payloads up to the inline
+// capacity (sized for a typical chat line) live inside the object and
+// never touch the heap; larger ones take a single heap allocation.
+class MessageText {
+public:
+    MessageText();
+    MessageText(std::string_view text);
+    MessageText(MessageText&& other) noexcept;
+    MessageText& operator=(MessageText&& other) noexcept;
+    MessageText& operator=(std::string_view text);
+    MessageText(const MessageText&) = delete;
+    MessageText& operator=(const MessageText&) = delete;
+    ~MessageText();
+
+    const char* c_str() const { return heap ? heap : inline_buf; }
+    std::string_view view() const { return std::string_view(c_str(), length); }
+    size_t size() const { return length; }
+    bool is_inline() const { return heap == nullptr; }
+
+private:
+    void assign(std::string_view text);
+    void release();
+
+    static constexpr size_t INLINE_CAPACITY = 119; // +1 for the NUL = 120 bytes
+    char inline_buf[INLINE_CAPACITY + 1];
+    char* heap;
+    size_t length;
 };
 
 struct Message {
+    Message() = default;
+    Message(MessageType type, std::string_view text) : type(type), message(text) {}
+    Message(Message&&) = default;
+    Message& operator=(Message&&) = default;
+
     MessageType type;
-    std::string message;
+    MessageText message;
+};
+
+// Zero-copy view of a pumped event. All views and record pointers alias
+// the FFI-owned pump arena and are only valid until the next pump call.
+struct EventView {
+    MessageType type;
+    // JSON payload (compatibility form)
+    std::string_view message;
+
+    // Typed payload, already parsed on the Rust side: friend events carry
+    // WarhorseFriendRecord entries, chat messages one WarhorseChatRecord.
+    const warhorse::WarhorseFriendRecord* friends = nullptr;
+    size_t friend_count = 0;
+    const warhorse::WarhorseChatRecord* chat = nullptr;
+
+    // Resolves an arena string reference out of a record field.
+    std::string_view str(const warhorse::WarhorseStringRef& ref) const {
+        return std::string_view(arena + ref.offset, ref.len);
+    }
+
+    const char* arena = nullptr;
 };
 
 typedef std::function<void(const char*)> WarhorseCallback;
 
+// Coalesced presence notification: the changed roster entries from one
+// pump, deduplicated through the roster cache's dirty set.
+typedef std::function<void(std::span<const RosterEntry* const>)> PresenceCallback;
+
+// Hot-path counters, updated with relaxed atomics from the pump path and
+// readable from a telemetry thread at any time without locking. No string
+// formatting, no syscalls — a stalled social layer can be diagnosed in
+// production without adding cost to the path being diagnosed.
+struct ClientStats {
+    // events delivered, per MessageType
+    std::array<std::atomic<uint64_t>, MESSAGE_TYPE_COUNT> event_counts{};
+
+    std::atomic<uint64_t> pumps{0};
+    std::atomic<uint64_t> events_total{0};
+    std::atomic<uint64_t> payload_bytes{0};
+
+    // largest single pump batch seen, and deepest the SPSC ring has been
+    std::atomic<uint64_t> batch_high_water{0};
+    std::atomic<uint64_t> ring_depth_high_water{0};
+
+    // chat-history compression: payload bytes before and after the codec,
+    // for verifying the CPU/size trade per deployment
+    std::atomic<uint64_t> history_raw_bytes{0};
+    std::atomic<uint64_t> history_stored_bytes{0};
+
+    // heap allocations observed during conversion, when an allocation
+    // counter is wired in (see set_alloc_counter); proves the hot path
+    // stays allocation-free in production, not just on the bench box
+    std::atomic<uint64_t> pump_allocs{0};
+    std::atomic<uint64_t> pump_allocs_max{0};
+
+    // pump latency histogram: bucket i counts pumps that took
+    // [2^(i-1), 2^i) microseconds (bucket 0 is sub-microsecond)
+    static constexpr size_t LATENCY_BUCKETS = 20;
+    std::array<std::atomic<uint64_t>, LATENCY_BUCKETS> pump_latency_us{};
+
+    static void update_max(std::atomic<uint64_t>& slot, uint64_t value) {
+        uint64_t seen = slot.load(std::memory_order_relaxed);
+        while (value > seen &&
+               !slot.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+        }
+    }
+};
+
+struct LoginResult {
+    bool success;
+    std::string error;
+};
+
+// Builder for a batch of outbound operations. Ops accumulate in one
+// contiguous buffer and cross the FFI in a single client_send_batch call;
+// redundant non-chat ops (same op, same target) are coalesced on add.
+class OutboundBatch {
+public:
+    void room_message(std::string_view room, std::string_view message);
+    void whisper(std::string_view friend_id, std::string_view message);
+    void friend_request(std::string_view friend_id);
+    void accept_friend_request(std::string_view friend_id);
+    void reject_friend_request(std::string_view friend_id);
+    void remove_friend(std::string_view friend_id);
+    void block_user(std::string_view user_id);
+    void unblock_user(std::string_view user_id);
+
+    void clear();
+    size_t size() const { return ops.size(); }
+
+private:
+    friend class WarhorseClient;
+
+    void add(warhorse::WarhorseOutboundOpType op_type, std::string_view target, std::string_view message);
+    warhorse::WarhorseStringRef push_str(std::string_view s);
+    std::string_view resolve(const warhorse::WarhorseStringRef& ref) const;
+
+    std::vector<warhorse::WarhorseOutboundOp> ops;
+    std::vector<char> strings;
+};
+
 static void log(const std::string& message);
 
+// Threading policies for WarhorseClient. The FFI handle itself is safe to
+// share: the Rust core guards its socket and event queue internally, so
+// pump and send calls may come from different threads. What needs care on
+// this side is the login state machine — the flags plus the login_async
+// promise, written by the sending thread and completed by the pumping
+// thread.
+//
+// MultiThreadPolicy (the default) makes that handoff safe with atomics and
+// a mutex held only across promise completion. SingleThreadPolicy compiles
+// it all down to plain bools and empty locks for callers that drive the
+// client from one thread; select it with -DWARHORSE_SINGLE_THREADED.
+// Everything else — conversion scratch buffers, roster cache, string pool,
+// callbacks — always belongs to the pumping thread, and the built-in pump
+// thread hands messages over through the lock-free ring in either mode.
+struct SingleThreadPolicy {
+    using Flag = bool;
+    struct Mutex {
+        void lock() {}
+        void unlock() {}
+    };
+    static bool load(const Flag& flag) { return flag; }
+    static void store(Flag& flag, bool value) { flag = value; }
+};
+
+struct MultiThreadPolicy {
+    using Flag = std::atomic<bool>;
+    using Mutex = std::mutex;
+    static bool load(const Flag& flag) { return flag.load(std::memory_order_acquire); }
+    static void store(Flag& flag, bool value) { flag.store(value, std::memory_order_release); }
+};
+
+#ifdef WARHORSE_SINGLE_THREADED
+using ThreadPolicy = SingleThreadPolicy;
+#else
+using ThreadPolicy = MultiThreadPolicy;
+#endif
+
+// Tag selecting the deferred-connection constructor.
+struct DeferConnect {};
+
 class WarhorseClient {
 public:
-    WarhorseClient(const std::string& connection_string);
+    WarhorseClient(const std::string& connection_string, size_t pump_batch_size = 32);
+
+    // Subscribing constructor: only events in event_mask (an OR of
+    // event_bit values) are serialized and delivered; the rest are dropped
+    // on the Rust side before any payload work. Pair the same mask with
+    // dispatch_subscribed for a fully dead-stripped event loop.
+    WarhorseClient(const std::string& connection_string, size_t pump_batch_size,
+                   uint32_t event_mask);
+
+    // Resuming constructor: restores a session from a blob exported by a
+    // previous client after LOGGED_IN. The login is pipelined into the
+    // connection setup — no waiting on Hello, no is_ready_for_login
+    // polling — so a warm restart reaches LOGGED_IN in one round trip.
+    // A malformed blob degrades to a cold client.
+    WarhorseClient(const std::string& connection_string, const std::string& resume_blob,
+                   size_t pump_batch_size);
+
+    // Deferred-connection constructor: returns immediately — no DNS, no
+    // TCP — so boot can construct the client and paint the friends UI from
+    // the local caches (roster snapshot, chat history) at frame one. The
+    // connection comes up on a background thread: until connected() flips,
+    // pumps deliver nothing, send_batch declines (the batch is kept for a
+    // later flush), and a login call is parked and pipelined the moment the
+    // transport exists. The handoff uses real synchronization even under
+    // WARHORSE_SINGLE_THREADED, since the background thread is inherent.
+    WarhorseClient(DeferConnect, const std::string& connection_string,
+                   size_t pump_batch_size = 32, uint32_t event_mask = EVENT_MASK_ALL);
     ~WarhorseClient();
+
+    // Whether the FFI handle exists yet. Always true for the non-deferred
+    // constructors.
+    bool connected() const { return connect_done.load(std::memory_order_acquire); }
     bool login(const std::string& username, const std::string& password);
+
+    // Opaque session-resumption blob, valid once LOGGED_IN has been pumped
+    // (empty before that). Persist it across restarts and feed it to the
+    // resuming constructor; treat the contents as opaque — the format will
+    // absorb server-issued resume tokens when the protocol grows them.
+    // Until then the blob carries the plaintext credentials, so store it
+    // like a credential — platform keystore or encrypted at rest — never
+    // in a plain config file.
+    std::string export_resume_blob() const;
+
+    // Sends the login immediately — pipelined, without waiting for Hello —
+    // and completes the future from the event path when LoggedIn (or an
+    // Error while the login is pending) is pumped.
+    std::future<LoginResult> login_async(const std::string& username, const std::string& password);
+
+    // Flushes a batch of outbound ops in one FFI crossing; returns the
+    // number of ops queued. The batch is cleared for reuse.
+    size_t send_batch(OutboundBatch& batch);
     bool pump_messages(std::vector<Message>& messages);
+
+    // Allocator-agnostic pump_messages: any vector-like container of
+    // Message works, so engines that route frame containers through a
+    // bump arena (see arena_alloc.h) keep the conversion off the global
+    // heap entirely.
+    template <typename MessageVector>
+    bool pump_messages_into(MessageVector& messages) {
+        size_t event_count = pump_events(event_views);
+        for (size_t i = 0; i < event_count; i++) {
+            messages.emplace_back(event_views[i].type, event_views[i].message);
+        }
+        return event_count > 0;
+    }
+
+    // Deadline-bounded pump_messages: converts events until the monotonic
+    // deadline passes, then carries the already-fetched remainder to the
+    // next call without re-crossing the FFI — the batch stays parked in
+    // the pump arena, which is valid until the next fetch. Makes the
+    // social layer a fixed line item in a frame budget instead of a
+    // variance source. Returns events converted this call; while a
+    // remainder is carried, don't interleave other pump/dispatch calls
+    // (they would overwrite the arena under it).
+    size_t pump_messages_until(std::vector<Message>& messages,
+                               std::chrono::steady_clock::time_point deadline);
+
+    // Events fetched but not yet converted by pump_messages_until.
+    size_t carried_events() const { return carry_count - carry_begin; }
+
+    size_t pump_events(std::span<EventView> out_events);
+
+    // Priority-tiered pump: control events (login, errors, rosters) are
+    // delivered first and in full; bulk chat is capped at bulk_budget per
+    // pump, and with drop_oldest the stalest chat beyond the budget is
+    // discarded. Bounds time-to-interactive after a reconnect flood.
+    size_t pump_events_prioritized(std::span<EventView> out_events,
+                                   size_t bulk_budget, bool drop_oldest = false);
+
+    // Loops pump_messages until the Rust-side queue is empty, for draining
+    // large backlogs (e.g. after a reconnect) in one call.
+    size_t drain_all(std::vector<Message>& messages);
+
+    // Events still queued on the Rust side, for adaptively sizing pumps.
+    size_t pending_events() const;
+
+    // Logical reset for handle pooling: drains queued events, clears
+    // callbacks, roster and login state, but keeps the connection (and any
+    // Hello already received) alive, so the next owner of the handle skips
+    // connection establishment entirely. The wire protocol has no logout
+    // yet, so a handle released after login stays authenticated until it
+    // is logged in again; pools should prefer recycling pre-login handles.
+    void reset_for_reuse();
+
+    // Roster kept current from friend events as they are pumped; a presence
+    // flip updates one cached record instead of rebuilding the list.
+    const RosterCache& roster() const { return roster_cache; }
+
+    // Local roster persistence for the startup fast-path: loads the
+    // snapshot at snapshot_path immediately (an mmap and a pointer walk, no
+    // server round trip), so roster() serves entries before the connection
+    // is up, and rewrites the file whenever a fresh FRIENDS_LIST lands.
+    // Pair it with the deferred constructor: the first server roster is
+    // diffed against the loaded entries, and the dirty set hands exactly
+    // the offline delta to bind_on_presence_changed.
+    void enable_roster_snapshot(const std::string& snapshot_path);
+
+    // Lock-free view of the hot-path counters for the telemetry thread.
+    const ClientStats& stats() const { return client_stats; }
+
+    // Wires an allocation counter (e.g. one fed by a counting operator
+    // new in debug/CI builds) into the pump path: each conversion pass
+    // samples it before and after, and the delta lands in
+    // ClientStats::pump_allocs. Costs two indirect calls per pump when
+    // set, nothing when not.
+    typedef uint64_t (*AllocCounterFn)();
+    void set_alloc_counter(AllocCounterFn counter) { alloc_counter = counter; }
+
+    // Interning pool for payload fragments that repeat across events
+    // (sender names, channel names). Consumers that retain strings past the
+    // pump should intern them here instead of copying: a repeat costs a
+    // hash lookup and refcount bump, and comparisons become pointer checks.
+    // Owned by whichever thread drains events; see StringPool's contract.
+    StringPool& strings() { return string_pool; }
+
+    // Scans a list-shaped JSON payload (FRIENDS_LIST, FRIEND_REQUESTS,
+    // BLOCKED_LIST compatibility form) and walks its objects lazily:
+    // fn(const JsonObjectView&), fields pulled on demand with field().
+    // Run it per event type from a pump loop when the typed records are
+    // not enough; the scanner's index buffer is reused, so the steady
+    // state allocates nothing. Views are valid only inside fn.
+    template <typename Fn>
+    size_t for_each_json_object(std::string_view payload, Fn&& fn) {
+        json_scanner.scan(payload);
+        return json_scanner.for_each_object(std::forward<Fn>(fn));
+    }
+
+    // The underlying scanner, for callers that keep views across fields.
+    JsonScanner& json() { return json_scanner; }
+
+    // Local persistent chat history. Once enabled, pumped chat messages are
+    // appended to a per-channel mmap-backed store, so a warm channel open
+    // reads local history instead of re-requesting it from the server.
+    // With compress set, payloads go through the dictionary-primed codec
+    // (see PayloadCodec); stats() tracks raw vs stored bytes so the
+    // CPU/size trade is measurable per deployment.
+    void enable_chat_history(const std::string& history_dir, bool compress = false);
+    ChatHistoryStore* chat_history() { return history_store.get(); }
+    bool wait_for_events(std::chrono::milliseconds timeout);
+
+    // Built-in pump thread: crosses the FFI and converts payloads off the
+    // game thread, feeding a lock-free single-producer/single-consumer ring.
+    // While the thread runs, do not call pump_messages/pump_events yourself;
+    // drain with try_dequeue (one relaxed atomic load when the ring is empty).
+    void start_pump_thread();
+    void stop_pump_thread();
+    bool try_dequeue(Message& out_message);
     bool is_ready_for_login() const;
 
-    // Callbacks
-    WarhorseCallback on_hello;
-    WarhorseCallback on_logged_in;
-    WarhorseCallback on_error;
-    WarhorseCallback on_friend_requests;
-    WarhorseCallback on_friends_list;
-    WarhorseCallback on_blocked_list;
-    WarhorseCallback on_friend_request_accepted;
-    WarhorseCallback on_chat_message;
+    // Pumps once and routes each event straight to its bound callback
+    // through a flat table indexed by event type: one indirect call per
+    // event, no switch cascades. Arena payload strings are NUL-terminated,
+    // so callbacks get them without a copy. Returns events delivered.
+    size_t dispatch();
+
+    // Statically-bound variant: handler(const EventView&) is called
+    // directly, so the compiler can inline per-event handling at the call
+    // site with no std::function indirection at all.
+    template <typename Handler>
+    size_t dispatch_with(Handler&& handler) {
+        size_t event_count = pump_events(event_views);
+        for (size_t i = 0; i < event_count; i++) {
+            handler(event_views[i]);
+        }
+        return event_count;
+    }
+
+    // Binary payload mode: friend and chat events stop carrying the
+    // compatibility JSON (EventView::message comes back empty for them)
+    // and are consumed through the typed records alone, which removes the
+    // serde cost from every pump. Control events keep their JSON. Leave
+    // this off if any consumer still reads message for those types.
+    // On-the-wire binary framing on top of this needs the server to
+    // negotiate it at Hello; this is where that lands when it does.
+    void use_binary_payloads(bool enabled);
+
+    // Scatter pump: each event is routed straight into the sink registered
+    // for its type during the single conversion pass, so engines with
+    // per-system queues (chat, social UI, telemetry) stop re-partitioning
+    // a combined vector afterwards — every event is touched once. Sinks
+    // are caller-owned; events whose type has no sink are dropped.
+    // Returns the number of events routed.
+    void bind_sink(MessageType type, std::vector<Message>* sink) { sinks[type] = sink; }
+    size_t pump_scatter();
+
+    // Subscription-masked variant of dispatch_with: Mask is a compile-time
+    // constant, so the per-event test folds to a bit check and handler
+    // code for suppressed types is eliminated outright — no std::function
+    // storage, no dead branches. Use the same mask on the constructor so
+    // suppressed events never cross the FFI in the first place.
+    template <uint32_t Mask, typename Handler>
+    size_t dispatch_subscribed(Handler&& handler) {
+        size_t event_count = pump_events(event_views);
+        size_t delivered = 0;
+        for (size_t i = 0; i < event_count; i++) {
+            if constexpr (Mask != EVENT_MASK_ALL) {
+                if (((Mask >> event_views[i].type) & 1u) == 0) {
+                    continue;
+                }
+            }
+            handler(event_views[i]);
+            delivered++;
+        }
+        return delivered;
+    }
 
     // Binds to callbacks
-    void bind_on_hello(WarhorseCallback cb) { on_hello = cb; }
-    void bind_on_logged_in(WarhorseCallback cb) { on_logged_in = cb; }
-    void bind_on_error(WarhorseCallback cb) { on_error = cb; }
-    void bind_on_friend_requests(WarhorseCallback cb) { on_friend_requests = cb; }
-    void bind_on_friends_list(WarhorseCallback cb) { on_friends_list = cb; }
-    void bind_on_blocked_list(WarhorseCallback cb) { on_blocked_list = cb; }
-    void bind_on_friend_request_accepted(WarhorseCallback cb) { on_friend_request_accepted = cb; }
-    void bind_on_chat_message(WarhorseCallback cb) { on_chat_message = cb; }
+    void bind_on_hello(WarhorseCallback cb) { callbacks[HELLO] = cb; }
+    void bind_on_logged_in(WarhorseCallback cb) { callbacks[LOGGED_IN] = cb; }
+    void bind_on_error(WarhorseCallback cb) { callbacks[ERROR] = cb; }
+    void bind_on_friend_requests(WarhorseCallback cb) { callbacks[FRIEND_REQUESTS] = cb; }
+    void bind_on_friends_list(WarhorseCallback cb) { callbacks[FRIENDS_LIST] = cb; }
+    void bind_on_blocked_list(WarhorseCallback cb) { callbacks[BLOCKED_LIST] = cb; }
+    void bind_on_friend_request_accepted(WarhorseCallback cb) { callbacks[FRIEND_REQUEST_ACCEPTED] = cb; }
+    void bind_on_chat_message(WarhorseCallback cb) { callbacks[CHAT_MESSAGE] = cb; }
+
+    // Fires at most once per pump with every roster entry that changed in
+    // it, however many presence events arrived: refresh cost scales with
+    // changed entries per frame, not raw event rate. Entry pointers are
+    // valid until the next roster mutation. A burst of flips to the same
+    // friend collapses to one entry in the view.
+    void bind_on_presence_changed(PresenceCallback cb) { presence_callback = std::move(cb); }
 private:
-    bool logged_in;
-    bool received_hello;
-    bool sent_login_request;
+    // Callback table indexed by MessageType
+    std::array<WarhorseCallback, MESSAGE_TYPE_COUNT> callbacks;
+
+    // Caller-owned per-type destination queues for pump_scatter
+    std::array<std::vector<Message>*, MESSAGE_TYPE_COUNT> sinks;
+
+    PresenceCallback presence_callback;
+    std::vector<const RosterEntry*> dirty_scratch;
+    AllocCounterFn alloc_counter;
+
+    void pump_thread_main();
+    bool try_enqueue(Message&& message);
+    void init(size_t pump_batch_size);
+    size_t finish_pump(size_t event_count, const char* arena, std::span<EventView> out_events,
+                       std::chrono::steady_clock::time_point pump_start);
+
+    // The handle, gated on connection completion: null while a deferred
+    // connection is still coming up, so callers on the pump/send paths
+    // degrade instead of crossing the FFI with nothing behind it.
+    warhorse::WarhorseClientHandle* live_handle() const {
+        return connect_done.load(std::memory_order_acquire) ? handle : nullptr;
+    }
+
+    ThreadPolicy::Flag logged_in;
+    ThreadPolicy::Flag received_hello;
+    ThreadPolicy::Flag sent_login_request;
+
+    // Credential material captured on login for export_resume_blob
+    std::string resume_username;
+    std::string resume_password;
     warhorse::WarhorseClientHandle* handle;
+
+    // Deferred-connection state. connect_mutex covers handle plus the
+    // parked login/settings against the background connect thread; it is a
+    // plain std::mutex on purpose — the thread exists in every policy.
+    std::thread connect_thread;
+    std::atomic<bool> connect_done;
+    std::mutex connect_mutex;
+    std::string deferred_username;
+    std::string deferred_password;
+    bool deferred_binary;
+
+    // Snapshot file rewritten on each FRIENDS_LIST when non-empty
+    std::string roster_snapshot_path;
+
+    RosterCache roster_cache;
+    ClientStats client_stats;
+    StringPool string_pool;
+    JsonScanner json_scanner;
+    std::unique_ptr<ChatHistoryStore> history_store;
+
+    // Outstanding login_async completion, if any; the mutex covers the
+    // send-thread/pump-thread handoff of the promise.
+    ThreadPolicy::Mutex login_mutex;
+    std::unique_ptr<std::promise<LoginResult>> login_promise;
+
+    // Max events fetched per FFI crossing; reused pump-call scratch buffers
+    size_t pump_batch_size;
+    std::vector<warhorse::WarhorseEventRef> event_refs;
+    std::vector<EventView> event_views;
+
+    // Remainder window into event_views for pump_messages_until
+    size_t carry_begin;
+    size_t carry_count;
+
+    // SPSC ring between the pump thread (producer) and the game thread
+    // (consumer); capacity must stay a power of two for the index masking.
+    static constexpr size_t RING_CAPACITY = 1024;
+    std::vector<Message> ring;
+    std::atomic<size_t> ring_head; // next slot to read, owned by consumer
+    std::atomic<size_t> ring_tail; // next slot to write, owned by producer
+    std::thread pump_thread;
+    std::atomic<bool> pump_thread_running;
 };
\ No newline at end of file
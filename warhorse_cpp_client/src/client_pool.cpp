@@ -0,0 +1,103 @@
+#include "client_pool.h"
+
+WarhorseClientPool::WarhorseClientPool(const std::string& connection_string) {
+    this->connection_string = connection_string;
+    next_session_id = 1;
+    spare_target = 0;
+}
+
+SessionId WarhorseClientPool::open_session() {
+    Session session;
+    session.id = next_session_id++;
+    session.client = acquire();
+    sessions.push_back(std::move(session));
+    return sessions.back().id;
+}
+
+void WarhorseClientPool::close_session(SessionId session) {
+    for (size_t i = 0; i < sessions.size(); i++) {
+        if (sessions[i].id == session) {
+            release(std::move(sessions[i].client));
+            sessions.erase(sessions.begin() + i);
+            return;
+        }
+    }
+}
+
+void WarhorseClientPool::set_spare_target(size_t count) {
+    spare_target = count;
+    top_up_spares();
+}
+
+std::unique_ptr<WarhorseClient> WarhorseClientPool::acquire() {
+    std::unique_ptr<WarhorseClient> client;
+    if (!spares.empty()) {
+        client = std::move(spares.back());
+        spares.pop_back();
+    } else {
+        client = std::make_unique<WarhorseClient>(connection_string);
+    }
+    // Start replacements connecting now, so the next acquire is warm too.
+    top_up_spares();
+    return client;
+}
+
+void WarhorseClientPool::release(std::unique_ptr<WarhorseClient> client) {
+    if (client == nullptr) {
+        return;
+    }
+    if (spares.size() >= spare_target) {
+        return; // above target: let it tear down
+    }
+    client->reset_for_reuse();
+    spares.push_back(std::move(client));
+}
+
+void WarhorseClientPool::top_up_spares() {
+    while (spares.size() < spare_target) {
+        spares.push_back(std::make_unique<WarhorseClient>(connection_string));
+    }
+}
+
+bool WarhorseClientPool::login(SessionId session, const std::string& username, const std::string& password) {
+    Session* found = find_session(session);
+    if (found == nullptr) {
+        return false;
+    }
+    return found->client->login(username, password);
+}
+
+size_t WarhorseClientPool::pump_all() {
+
+    constexpr size_t MAX_EVENTS = 32;
+    EventView events[MAX_EVENTS];
+
+    size_t total = 0;
+    for (Session& session : sessions) {
+        size_t event_count = session.client->pump_events(events);
+        for (size_t i = 0; i < event_count; i++) {
+            session.queue.emplace_back(events[i].type, events[i].message);
+        }
+        total += event_count;
+    }
+    return total;
+}
+
+bool WarhorseClientPool::next_event(SessionId session, Message& out_message) {
+    Session* found = find_session(session);
+    if (found == nullptr || found->queue.empty()) {
+        return false;
+    }
+    out_message = std::move(found->queue.front());
+    found->queue.pop_front();
+    return true;
+}
+
+WarhorseClientPool::Session* WarhorseClientPool::find_session(SessionId session) {
+    for (Session& candidate : sessions) {
+        if (candidate.id == session) {
+            return &candidate;
+        }
+    }
+    return nullptr;
+}
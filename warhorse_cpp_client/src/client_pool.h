@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+#include "client.h"
+
+typedef uint32_t SessionId;
+
+// Hosts many logical sessions behind one object, for dedicated servers that
+// log in a client per player session. One pump_all pass drives every session
+// and fans events out into per-session queues, so the server tick makes one
+// call instead of N and the conversion buffers are shared across sessions.
+//
+// Each session still owns its own connection underneath: the wire protocol
+// has no session tagging, so true single-connection multiplexing needs
+// server support first. The pool keeps the call surface ready for that.
+class WarhorseClientPool {
+public:
+    WarhorseClientPool(const std::string& connection_string);
+
+    SessionId open_session();
+    void close_session(SessionId session);
+    bool login(SessionId session, const std::string& username, const std::string& password);
+
+    // Pumps every session in one pass; returns total events queued.
+    size_t pump_all();
+
+    // Pops the next queued event for a session, if any.
+    bool next_event(SessionId session, Message& out_message);
+
+    size_t session_count() const { return sessions.size(); }
+
+    // Warm-spare handle recycling. Constructing a WarhorseClient starts
+    // its connection immediately, so a spare built ahead of demand has
+    // already finished (or nearly finished) its handshake by the time a
+    // match needs it: acquire() becomes a pointer move instead of a
+    // connection establishment. release() logically resets the client and
+    // returns it to the spare set; handles beyond the target are freed.
+    // open_session/close_session recycle through the same set.
+    void set_spare_target(size_t count);
+    std::unique_ptr<WarhorseClient> acquire();
+    void release(std::unique_ptr<WarhorseClient> client);
+    size_t spare_count() const { return spares.size(); }
+
+private:
+    struct Session {
+        SessionId id;
+        std::unique_ptr<WarhorseClient> client;
+        std::deque<Message> queue;
+    };
+
+    Session* find_session(SessionId session);
+    void top_up_spares();
+
+    std::string connection_string;
+    SessionId next_session_id;
+    std::vector<Session> sessions;
+    size_t spare_target;
+    std::vector<std::unique_ptr<WarhorseClient>> spares;
+};
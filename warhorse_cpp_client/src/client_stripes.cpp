@@ -0,0 +1,54 @@
+#include "client_stripes.h"
+
+#include <functional>
+
+WarhorseClientStripes::WarhorseClientStripes(const std::string& connection_string,
+                                             size_t stripe_count, size_t pump_batch_size) {
+    if (stripe_count == 0) {
+        stripe_count = 1;
+    }
+    stripes.reserve(stripe_count);
+    batches.resize(stripe_count);
+    for (size_t i = 0; i < stripe_count; i++) {
+        stripes.push_back(std::make_unique<WarhorseClient>(connection_string, pump_batch_size));
+    }
+}
+
+size_t WarhorseClientStripes::login(const std::string& username, const std::string& password) {
+    size_t queued = 0;
+    for (auto& stripe : stripes) {
+        if (stripe->login(username, password)) {
+            queued++;
+        }
+    }
+    return queued;
+}
+
+size_t WarhorseClientStripes::stripe_for(std::string_view channel) const {
+    return std::hash<std::string_view>{}(channel) % stripes.size();
+}
+
+OutboundBatch& WarhorseClientStripes::batch_for(std::string_view channel) {
+    return batches[stripe_for(channel)];
+}
+
+size_t WarhorseClientStripes::flush() {
+    size_t queued = 0;
+    for (size_t i = 0; i < stripes.size(); i++) {
+        if (batches[i].size() > 0) {
+            queued += stripes[i]->send_batch(batches[i]);
+        }
+    }
+    return queued;
+}
+
+size_t WarhorseClientStripes::pump_events(std::span<EventView> out_events) {
+    size_t total = 0;
+    for (auto& stripe : stripes) {
+        if (total == out_events.size()) {
+            break;
+        }
+        total += stripe->pump_events(out_events.subspan(total));
+    }
+    return total;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "client.h"
+
+// Fans one logical client out over N connections for ingest volumes a
+// single connection cannot move (one socket tops out around one core).
+// Channel-affine work is hashed to a stripe, so a given channel always
+// lives on the same connection: each stripe preserves its own arrival
+// order, and since a channel never crosses stripes, per-channel ordering
+// survives the merge no matter how pump interleaves them. Throughput
+// scales with stripes because the connections (and, with the built-in
+// pump threads, their conversion work) run on separate cores.
+class WarhorseClientStripes {
+public:
+    WarhorseClientStripes(const std::string& connection_string, size_t stripe_count,
+                          size_t pump_batch_size = 32);
+
+    // Logs every stripe in with the same account (spectator services run
+    // few logical accounts over many channels). Returns stripes queued.
+    size_t login(const std::string& username, const std::string& password);
+
+    // The stripe a channel (room or friend id) is pinned to. Use it to
+    // address per-stripe state; subscriptions and sends for that channel
+    // must all go through this stripe to keep ordering.
+    size_t stripe_for(std::string_view channel) const;
+
+    // Per-stripe outbound batch, keyed by the channel the ops target;
+    // flush() sends every non-empty batch, one FFI crossing per stripe.
+    OutboundBatch& batch_for(std::string_view channel);
+    size_t flush();
+
+    // Merged pump: drains stripes in turn into out_events until the span
+    // is full or every stripe is dry. Views follow the usual contract per
+    // stripe arena (valid until that stripe's next pump).
+    size_t pump_events(std::span<EventView> out_events);
+
+    // Direct access for per-stripe wiring (sinks, callbacks, stats).
+    WarhorseClient& stripe(size_t index) { return *stripes[index]; }
+    size_t stripe_count() const { return stripes.size(); }
+
+private:
+    std::vector<std::unique_ptr<WarhorseClient>> stripes;
+    std::vector<OutboundBatch> batches;
+};
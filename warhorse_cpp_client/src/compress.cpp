@@ -0,0 +1,171 @@
+#include "compress.h"
+
+#include <cstring>
+
+namespace {
+
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t MAX_OFFSET = 65535;
+constexpr size_t HASH_BITS = 12;
+constexpr uint32_t NO_POS = UINT32_MAX;
+
+inline uint32_t hash4(const char* p) {
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// Writes a length that overflowed its 4-bit nibble: 255-chunks, then the
+// remainder byte (LZ4's extension scheme).
+void put_extended(std::vector<char>& dst, size_t value) {
+    while (value >= 255) {
+        dst.push_back(static_cast<char>(255));
+        value -= 255;
+    }
+    dst.push_back(static_cast<char>(value));
+}
+
+void emit_sequence(std::vector<char>& dst, const char* literals, size_t lit_len,
+                   size_t offset, size_t match_len) {
+    size_t lit_nibble = lit_len < 15 ? lit_len : 15;
+    size_t match_extra = match_len == 0 ? 0 : match_len - MIN_MATCH;
+    size_t match_nibble = match_extra < 15 ? match_extra : 15;
+
+    dst.push_back(static_cast<char>((lit_nibble << 4) | match_nibble));
+    if (lit_nibble == 15) {
+        put_extended(dst, lit_len - 15);
+    }
+    dst.insert(dst.end(), literals, literals + lit_len);
+
+    if (match_len == 0) {
+        return; // final literals-only sequence
+    }
+    dst.push_back(static_cast<char>(offset & 0xff));
+    dst.push_back(static_cast<char>((offset >> 8) & 0xff));
+    if (match_nibble == 15) {
+        put_extended(dst, match_extra - 15);
+    }
+}
+
+// Reads an extension-encoded length; false when the input runs out.
+bool get_extended(const char*& in, const char* in_end, size_t& value) {
+    uint8_t byte;
+    do {
+        if (in == in_end) {
+            return false;
+        }
+        byte = static_cast<uint8_t>(*in++);
+        value += byte;
+    } while (byte == 255);
+    return true;
+}
+
+} // namespace
+
+PayloadCodec::PayloadCodec(std::string_view dictionary)
+    : dict(dictionary) {
+    if (dict.size() > MAX_OFFSET) {
+        dict.resize(MAX_OFFSET);
+    }
+}
+
+size_t PayloadCodec::compress(std::string_view src, std::vector<char>& dst) {
+    size_t start_size = dst.size();
+
+    window.assign(dict.begin(), dict.end());
+    window.insert(window.end(), src.begin(), src.end());
+    hash_table.assign(size_t(1) << HASH_BITS, NO_POS);
+
+    const char* base = window.data();
+    size_t end = window.size();
+
+    // Prime the table with the dictionary so the first record bytes can
+    // already back-reference it.
+    for (size_t p = 0; p + MIN_MATCH <= dict.size(); p++) {
+        hash_table[hash4(base + p)] = static_cast<uint32_t>(p);
+    }
+
+    size_t pos = dict.size();
+    size_t lit_start = pos;
+    while (pos + MIN_MATCH <= end) {
+        uint32_t h = hash4(base + pos);
+        uint32_t cand = hash_table[h];
+        hash_table[h] = static_cast<uint32_t>(pos);
+
+        if (cand != NO_POS && pos - cand <= MAX_OFFSET &&
+            std::memcmp(base + cand, base + pos, MIN_MATCH) == 0) {
+            size_t len = MIN_MATCH;
+            while (pos + len < end && base[cand + len] == base[pos + len]) {
+                len++;
+            }
+            emit_sequence(dst, base + lit_start, pos - lit_start, pos - cand, len);
+            pos += len;
+            lit_start = pos;
+        } else {
+            pos++;
+        }
+    }
+
+    emit_sequence(dst, base + lit_start, end - lit_start, 0, 0);
+    return dst.size() - start_size;
+}
+
+bool PayloadCodec::decompress(std::string_view src, std::vector<char>& dst) {
+    // Back-references resolve against dict + output produced so far.
+    window.assign(dict.begin(), dict.end());
+
+    const char* in = src.data();
+    const char* in_end = in + src.size();
+
+    while (in != in_end) {
+        uint8_t token = static_cast<uint8_t>(*in++);
+
+        size_t lit_len = token >> 4;
+        if (lit_len == 15 && !get_extended(in, in_end, lit_len)) {
+            return false;
+        }
+        if (static_cast<size_t>(in_end - in) < lit_len) {
+            return false;
+        }
+        window.insert(window.end(), in, in + lit_len);
+        in += lit_len;
+
+        if (in == in_end) {
+            break; // final literals-only sequence
+        }
+
+        if (in_end - in < 2) {
+            return false;
+        }
+        size_t offset = static_cast<uint8_t>(in[0]) |
+                        (static_cast<size_t>(static_cast<uint8_t>(in[1])) << 8);
+        in += 2;
+
+        size_t match_len = (token & 0x0f) + MIN_MATCH;
+        if ((token & 0x0f) == 15 && !get_extended(in, in_end, match_len)) {
+            return false;
+        }
+        if (offset == 0 || offset > window.size()) {
+            return false;
+        }
+        // Byte-wise copy: matches may overlap their own output.
+        size_t from = window.size() - offset;
+        for (size_t i = 0; i < match_len; i++) {
+            window.push_back(window[from + i]);
+        }
+    }
+
+    dst.insert(dst.end(), window.begin() + dict.size(), window.end());
+    return true;
+}
+
+std::string_view PayloadCodec::default_dictionary() {
+    // Fragments lifted from real payload shapes; most records start by
+    // back-referencing several of these.
+    static constexpr std::string_view DICTIONARY =
+        "{\"display_name\":\"\",\"channel\":{\"Room\":\"general\"},"
+        "{\"PrivateMessage\":\"\",\"message\":\"\",\"time\":"
+        "{\"id\":\"user_\",\"status\":\"Online\"}"
+        "\"Offline\"\"Blocked\"\"FriendRequestSent\"\"FriendRequestReceived\"";
+    return DICTIONARY;
+}
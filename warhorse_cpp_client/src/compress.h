@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <string>
+#include <vector>
+
+// Small LZ77 codec for local payload storage. Greedy four-byte matches are
+// found through a hash table over a window primed with a shared
+// dictionary, so short repetitive records (chat lines, roster entries)
+// compress well from their very first byte instead of needing a warm-up.
+// The sequence format follows LZ4's shape — token byte with literal-run
+// and match-length nibbles (15 = extension bytes), raw literals, 16-bit
+// back-reference offset — and the final sequence is literals-only.
+//
+// Self-contained on purpose: the history store must build everywhere the
+// client does, and records are small enough that a dictionary-primed
+// greedy pass captures most of what a heavier codec would.
+class PayloadCodec {
+public:
+    explicit PayloadCodec(std::string_view dictionary);
+
+    // Appends the compressed form of src to dst; returns the stored size.
+    size_t compress(std::string_view src, std::vector<char>& dst);
+
+    // Appends the decompressed form of src to dst; returns false if the
+    // input is malformed (dst may hold a partial record then).
+    bool decompress(std::string_view src, std::vector<char>& dst);
+
+    // Dictionary of Warhorse payload shapes: the JSON keys, channel and
+    // status strings that recur in nearly every record.
+    static std::string_view default_dictionary();
+
+private:
+    std::string dict;
+    std::vector<char> window;        // dict + current input, reused per call
+    std::vector<uint32_t> hash_table;
+};
@@ -6,6 +6,11 @@
 
 namespace warhorse {
 
+enum class WarhorseChatChannelType {
+  Room,
+  PrivateMessage,
+};
+
 enum class WarhorseEventType {
   Hello,
   LoggedIn,
@@ -17,6 +22,25 @@ enum class WarhorseEventType {
   ChatMessage,
 };
 
+enum class WarhorseFriendStatus {
+  Online,
+  Offline,
+  FriendRequestSent,
+  FriendRequestReceived,
+  Blocked,
+};
+
+enum class WarhorseOutboundOpType {
+  RoomMessage,
+  WhisperMessage,
+  FriendRequest,
+  AcceptFriendRequest,
+  RejectFriendRequest,
+  RemoveFriend,
+  BlockUser,
+  UnblockUser,
+};
+
 struct WarhorseClientHandle {
   uint8_t _private;
 };
@@ -26,20 +50,81 @@ struct WarhorseEventData {
   char *message;
 };
 
+struct WarhorseEventRef {
+  WarhorseEventType event_type;
+  uintptr_t message_offset;
+  uintptr_t message_len;
+  uintptr_t payload_offset;
+  uintptr_t payload_count;
+};
+
+struct WarhorseStringRef {
+  uintptr_t offset;
+  uintptr_t len;
+};
+
+struct WarhorseOutboundOp {
+  WarhorseOutboundOpType op_type;
+  WarhorseStringRef target;
+  WarhorseStringRef message;
+};
+
+struct WarhorseFriendRecord {
+  WarhorseStringRef id;
+  WarhorseStringRef display_name;
+  WarhorseFriendStatus status;
+};
+
+struct WarhorseChatRecord {
+  WarhorseStringRef display_name;
+  WarhorseChatChannelType channel_type;
+  WarhorseStringRef channel;
+  WarhorseStringRef message;
+  uint32_t time;
+};
+
 extern "C" {
 
 void use_log();
 
 WarhorseClientHandle *client_new(const char *connection_string);
 
+WarhorseClientHandle *client_new_with_mask(const char *connection_string, uint32_t event_mask);
+
 bool client_login_with_username(WarhorseClientHandle *handle,
                                 const char *username,
                                 const char *password);
 
+void client_use_binary_payloads(WarhorseClientHandle *handle, bool enabled);
+
 uintptr_t client_pump(WarhorseClientHandle *handle,
                       WarhorseEventData *events,
                       uintptr_t max_events);
 
+uintptr_t client_pump_arena(WarhorseClientHandle *handle,
+                            WarhorseEventRef *events,
+                            uintptr_t max_events,
+                            const char **arena_out);
+
+uintptr_t client_send_batch(WarhorseClientHandle *handle,
+                            const WarhorseOutboundOp *ops,
+                            uintptr_t op_count,
+                            const char *strings,
+                            uintptr_t strings_len);
+
+uintptr_t client_pending_events(WarhorseClientHandle *handle);
+
+bool client_wait_for_events(WarhorseClientHandle *handle, uint64_t timeout_ms);
+
+uintptr_t client_pump_arena_prioritized(WarhorseClientHandle *handle,
+                                        WarhorseEventRef *events,
+                                        uintptr_t max_events,
+                                        uintptr_t bulk_budget,
+                                        bool drop_oldest,
+                                        const char **arena_out);
+
+void release_pump_arena(WarhorseClientHandle *handle);
+
 void log_info(const char *message);
 
 void log_error(const char *message);
@@ -0,0 +1,82 @@
+#include "intern.h"
+
+InternedStr::InternedStr(const InternedStr& other) : entry(other.entry) {
+    if (entry != nullptr) {
+        entry->refs++;
+    }
+}
+
+InternedStr::InternedStr(InternedStr&& other) noexcept : entry(other.entry) {
+    other.entry = nullptr;
+}
+
+InternedStr& InternedStr::operator=(const InternedStr& other) {
+    if (this != &other) {
+        release();
+        entry = other.entry;
+        if (entry != nullptr) {
+            entry->refs++;
+        }
+    }
+    return *this;
+}
+
+InternedStr& InternedStr::operator=(InternedStr&& other) noexcept {
+    if (this != &other) {
+        release();
+        entry = other.entry;
+        other.entry = nullptr;
+    }
+    return *this;
+}
+
+InternedStr::~InternedStr() {
+    release();
+}
+
+std::string_view InternedStr::view() const {
+    return entry != nullptr ? std::string_view(entry->text) : std::string_view();
+}
+
+const char* InternedStr::c_str() const {
+    return entry != nullptr ? entry->text.c_str() : "";
+}
+
+void InternedStr::release() {
+    if (entry != nullptr) {
+        entry->refs--;
+        if (entry->refs == 0) {
+            if (entry->pool != nullptr) {
+                entry->pool->remove(entry);
+            } else {
+                delete entry; // pool already destroyed; see ~StringPool
+            }
+        }
+        entry = nullptr;
+    }
+}
+
+StringPool::~StringPool() {
+    // Outstanding handles may outlive the pool; orphan them so their final
+    // release does not reach back into a dead map.
+    for (auto& [_, entry] : entries) {
+        entry->pool = nullptr;
+    }
+}
+
+InternedStr StringPool::intern(std::string_view s) {
+    auto it = entries.find(s);
+    if (it != entries.end()) {
+        it->second->refs++;
+        return InternedStr(it->second);
+    }
+
+    InternedStr::Entry* entry = new InternedStr::Entry{ std::string(s), 1, this };
+    entries.emplace(std::string_view(entry->text), entry);
+    return InternedStr(entry);
+}
+
+void StringPool::remove(InternedStr::Entry* entry) {
+    entries.erase(std::string_view(entry->text));
+    delete entry;
+}
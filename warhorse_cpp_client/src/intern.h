@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+class StringPool;
+
+// Lightweight handle to a pooled string. Copies bump a refcount instead of
+// allocating; equality is a pointer compare, so repeated fragments like
+// sender and channel names resolve without touching the characters.
+class InternedStr {
+public:
+    InternedStr() : entry(nullptr) {}
+    InternedStr(const InternedStr& other);
+    InternedStr(InternedStr&& other) noexcept;
+    InternedStr& operator=(const InternedStr& other);
+    InternedStr& operator=(InternedStr&& other) noexcept;
+    ~InternedStr();
+
+    std::string_view view() const;
+    const char* c_str() const;
+    bool operator==(const InternedStr& other) const { return entry == other.entry; }
+    explicit operator bool() const { return entry != nullptr; }
+
+private:
+    friend class StringPool;
+
+    struct Entry {
+        std::string text;
+        size_t refs;
+        StringPool* pool;
+    };
+
+    explicit InternedStr(Entry* entry) : entry(entry) {}
+    void release();
+
+    Entry* entry;
+};
+
+// Hashed pool of deduplicated strings. Interning a fragment that is already
+// pooled costs a hash lookup and a refcount bump — no allocation — so the
+// steady-state event path stops allocating for names it has seen before.
+// Entries are dropped when their last handle goes away.
+//
+// Not synchronized: use one pool per thread that retains event strings
+// (typically the thread draining the pump).
+class StringPool {
+public:
+    StringPool() = default;
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+    ~StringPool();
+
+    InternedStr intern(std::string_view s);
+    size_t size() const { return entries.size(); }
+
+private:
+    friend class InternedStr;
+
+    void remove(InternedStr::Entry* entry);
+
+    // keys view the entry's own text, which is heap-stable
+    std::unordered_map<std::string_view, InternedStr::Entry*> entries;
+};
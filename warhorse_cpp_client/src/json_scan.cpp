@@ -0,0 +1,157 @@
+#include "json_scan.h"
+
+#include <bit>
+#include <cstring>
+
+namespace {
+
+constexpr uint64_t LOW_BITS = 0x0101010101010101ull;
+constexpr uint64_t HIGH_BITS = 0x8080808080808080ull;
+
+constexpr uint64_t broadcast(char c) {
+    return LOW_BITS * static_cast<uint8_t>(c);
+}
+
+// Classic zero-byte trick: the high bit of every byte of the result is set
+// exactly where word contains the byte c (for c < 0x80, which covers all
+// JSON structural characters).
+inline uint64_t match_byte(uint64_t word, char c) {
+    uint64_t x = word ^ broadcast(c);
+    return (x - LOW_BITS) & ~x & HIGH_BITS;
+}
+
+inline uint64_t classify(uint64_t word) {
+    return match_byte(word, '"') | match_byte(word, '\\') |
+           match_byte(word, '{') | match_byte(word, '}') |
+           match_byte(word, '[') | match_byte(word, ']') |
+           match_byte(word, ':') | match_byte(word, ',');
+}
+
+constexpr size_t NO_ESCAPE = SIZE_MAX;
+
+inline std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t' ||
+                          s.front() == '\n' || s.front() == '\r')) {
+        s.remove_prefix(1);
+    }
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' ||
+                          s.back() == '\n' || s.back() == '\r')) {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+} // namespace
+
+void JsonScanner::scan(std::string_view document) {
+    doc = document;
+    structurals.clear();
+
+    const char* data = document.data();
+    size_t size = document.size();
+
+    bool in_string = false;
+    // Position of the byte escaped by the last backslash seen; equality is
+    // all that matters, so a stale value is harmless once scanning passes it.
+    size_t escape_next = NO_ESCAPE;
+
+    auto handle = [&](size_t j) {
+        char c = data[j];
+        if (c == '\\') {
+            // An escaped backslash is a literal and escapes nothing itself.
+            escape_next = (j == escape_next) ? NO_ESCAPE : j + 1;
+        } else if (c == '"') {
+            if (j != escape_next) {
+                structurals.push_back(static_cast<uint32_t>(j));
+                in_string = !in_string;
+            }
+        } else if (!in_string) {
+            structurals.push_back(static_cast<uint32_t>(j));
+        }
+    };
+
+    size_t i = 0;
+    while (i + 8 <= size) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        uint64_t mask = classify(word);
+        // Interesting bytes are sparse (in chat payloads, most words are
+        // message text), so the common case is one test and an 8-byte skip.
+        while (mask != 0) {
+            handle(i + (static_cast<size_t>(std::countr_zero(mask)) >> 3));
+            mask &= mask - 1;
+        }
+        i += 8;
+    }
+    for (; i < size; i++) {
+        char c = data[i];
+        if (c == '"' || c == '\\' || c == '{' || c == '}' ||
+            c == '[' || c == ']' || c == ':' || c == ',') {
+            handle(i);
+        }
+    }
+}
+
+size_t JsonScanner::matching_close(size_t open_tok) const {
+    size_t depth = 0;
+    for (size_t t = open_tok; t < structurals.size(); t++) {
+        char c = token_char(t);
+        if (c == '"') {
+            t++; // skip the string's closing quote
+        } else if (c == '{' || c == '[') {
+            depth++;
+        } else if (c == '}' || c == ']') {
+            depth--;
+            if (depth == 0) {
+                return t;
+            }
+        }
+    }
+    return structurals.size();
+}
+
+std::string_view JsonObjectView::field(std::string_view key) const {
+    const JsonScanner& s = *scanner;
+
+    size_t t = open_tok + 1;
+    while (t + 2 < close_tok) {
+        // Each member is "key" ':' value; keys are always strings.
+        if (s.token_char(t) != '"' || s.token_char(t + 2) != ':') {
+            break;
+        }
+        bool hit = s.string_at(t) == key;
+
+        size_t value_tok = t + 3;
+        size_t value_end; // last token belonging to the value
+        char vc = value_tok < close_tok ? s.token_char(value_tok) : '}';
+        if (vc == '"') {
+            if (hit) {
+                return s.string_at(value_tok);
+            }
+            value_end = value_tok + 1;
+        } else if (vc == '{' || vc == '[') {
+            value_end = s.matching_close(value_tok);
+            if (hit) {
+                uint32_t begin = s.token_pos(value_tok);
+                return s.doc.substr(begin, s.token_pos(value_end) + 1 - begin);
+            }
+        } else {
+            // Scalar (number/keyword): no tokens of its own; it spans from
+            // just past the ':' to the next structural character.
+            if (hit) {
+                uint32_t begin = s.token_pos(t + 2) + 1;
+                return trim(s.doc.substr(begin, s.token_pos(value_tok) - begin));
+            }
+            value_end = t + 2;
+        }
+
+        // Past the value: a ',' token precedes the next member.
+        t = value_end + 1;
+        if (t < close_tok && s.token_char(t) == ',') {
+            t++;
+        } else {
+            break;
+        }
+    }
+    return std::string_view();
+}
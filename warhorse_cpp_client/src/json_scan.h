@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+class JsonScanner;
+
+// Lazily-materialized view of one object inside a scanned document.
+// field() walks the object's token range on demand; nothing is copied or
+// decoded until asked for, and string values are returned as the raw bytes
+// between the quotes (escapes are not decoded — protocol payloads carry
+// plain identifiers and display names).
+class JsonObjectView {
+public:
+    // Raw bytes of the named field's value, or an empty view if the field
+    // is missing. Strings come back unquoted, numbers/keywords trimmed,
+    // nested objects/arrays as their full raw span.
+    std::string_view field(std::string_view key) const;
+
+private:
+    friend class JsonScanner;
+    const JsonScanner* scanner;
+    size_t open_tok;  // token index of this object's '{'
+    size_t close_tok; // token index of the matching '}'
+};
+
+// Structural JSON scanner for the compatibility payloads (simdjson-style
+// two-stage design, with a portable SWAR first stage): scan() classifies
+// the document eight bytes at a word and records the positions of the
+// structural characters, then views navigate that index lazily instead of
+// parsing into a tree. The index buffer is reused across scans, so the
+// steady state allocates nothing; all views borrow the scanned document
+// and die with the next scan.
+class JsonScanner {
+public:
+    // Builds the structural index for doc. The scanner borrows doc's
+    // memory; previous views are invalidated.
+    void scan(std::string_view doc);
+
+    // Walks a top-level array of objects (the FRIENDS_LIST /
+    // FRIEND_REQUESTS payload shape), invoking fn(const JsonObjectView&)
+    // per element. Returns the number of objects visited.
+    template <typename Fn>
+    size_t for_each_object(Fn&& fn) const {
+        size_t count = 0;
+        if (structurals.empty() || token_char(0) != '[') {
+            return 0;
+        }
+        for (size_t t = 1; t < structurals.size(); t++) {
+            char c = token_char(t);
+            if (c == '{') {
+                JsonObjectView view;
+                view.scanner = this;
+                view.open_tok = t;
+                view.close_tok = matching_close(t);
+                fn(view);
+                count++;
+                t = view.close_tok;
+            } else if (c == ']') {
+                break;
+            }
+        }
+        return count;
+    }
+
+private:
+    friend class JsonObjectView;
+
+    char token_char(size_t t) const { return doc[structurals[t]]; }
+    uint32_t token_pos(size_t t) const { return structurals[t]; }
+    // For a token opening a string/object/array, the token index of its
+    // closing counterpart.
+    size_t matching_close(size_t open_tok) const;
+    std::string_view string_at(size_t quote_tok) const {
+        return doc.substr(structurals[quote_tok] + 1,
+                          structurals[quote_tok + 1] - structurals[quote_tok] - 1);
+    }
+
+    std::string_view doc;
+    // Positions of {}[]:, and string quotes (both of each pair), in order.
+    std::vector<uint32_t> structurals;
+};
@@ -0,0 +1,230 @@
+#include "roster.h"
+
+#include <cstdio>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static std::string_view arena_str(const warhorse::WarhorseStringRef& ref, const char* arena) {
+    return std::string_view(arena + ref.offset, ref.len);
+}
+
+// Snapshot framing: the magic line, a u32 entry count, then per entry a
+// u16 id length, u16 display-name length, u8 status, and the raw bytes.
+namespace {
+
+constexpr char SNAPSHOT_MAGIC[] = "WHRO1\n";
+constexpr size_t SNAPSHOT_MAGIC_LEN = sizeof(SNAPSHOT_MAGIC) - 1;
+
+} // namespace
+
+size_t RosterCache::apply_list(const warhorse::WarhorseFriendRecord* records, size_t count, const char* arena) {
+
+    size_t changed = 0;
+
+    // Upsert everything in the incoming list, remembering who we saw.
+    std::vector<bool> seen(storage.size(), false);
+    for (size_t i = 0; i < count; i++) {
+        std::string_view id = arena_str(records[i].id, arena);
+        if (upsert(id, arena_str(records[i].display_name, arena), records[i].status)) {
+            changed++;
+        }
+        auto it = index.find(id);
+        if (it != index.end() && it->second < seen.size()) {
+            seen[it->second] = true;
+        }
+    }
+
+    // Sweep entries that were not in the list (back to front so the
+    // swap-erase does not disturb unvisited slots).
+    for (size_t slot = seen.size(); slot > 0; slot--) {
+        if (!seen[slot - 1]) {
+            remove_at(slot - 1);
+            changed++;
+        }
+    }
+
+    if (changed > 0) {
+        change_version++;
+    }
+    return changed;
+}
+
+size_t RosterCache::apply_update(const warhorse::WarhorseFriendRecord& record, const char* arena) {
+    if (upsert(arena_str(record.id, arena), arena_str(record.display_name, arena), record.status)) {
+        change_version++;
+        return 1;
+    }
+    return 0;
+}
+
+const RosterEntry* RosterCache::find(std::string_view id) const {
+    auto it = index.find(id);
+    if (it == index.end()) {
+        return nullptr;
+    }
+    return &storage[it->second];
+}
+
+size_t RosterCache::collect_dirty(std::vector<const RosterEntry*>& out) {
+    size_t collected = 0;
+    for (size_t slot = 0; slot < storage.size() && collected < dirty_count; slot++) {
+        if (dirty[slot]) {
+            dirty[slot] = 0;
+            out.push_back(&storage[slot]);
+            collected++;
+        }
+    }
+    dirty_count = 0;
+    return collected;
+}
+
+void RosterCache::mark_dirty(size_t slot) {
+    if (!dirty[slot]) {
+        dirty[slot] = 1;
+        dirty_count++;
+    }
+}
+
+bool RosterCache::upsert(std::string_view id, std::string_view display_name,
+                         warhorse::WarhorseFriendStatus status) {
+    auto it = index.find(id);
+    if (it != index.end()) {
+        RosterEntry& entry = storage[it->second];
+        if (entry.display_name == display_name && entry.status == status) {
+            return false;
+        }
+        entry.display_name = display_name;
+        entry.status = status;
+        mark_dirty(it->second);
+        return true;
+    }
+
+    RosterEntry entry;
+    entry.id = id;
+    entry.display_name = display_name;
+    entry.status = status;
+    storage.push_back(std::move(entry));
+    index.emplace(std::string(id), storage.size() - 1);
+    dirty.push_back(0);
+    mark_dirty(storage.size() - 1);
+    return true;
+}
+
+bool RosterCache::load_snapshot(const std::string& path) {
+#ifdef _WIN32
+    (void)path;
+    return false;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < SNAPSHOT_MAGIC_LEN + 4) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t file_size = static_cast<size_t>(st.st_size);
+    const char* data = static_cast<const char*>(
+        mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0));
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    bool ok = std::memcmp(data, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_LEN) == 0;
+    size_t offset = SNAPSHOT_MAGIC_LEN;
+    uint32_t count = 0;
+    if (ok) {
+        std::memcpy(&count, data + offset, sizeof(count));
+        offset += sizeof(count);
+    }
+
+    for (uint32_t i = 0; ok && i < count; i++) {
+        if (offset + 5 > file_size) {
+            ok = false; // truncated (e.g. torn write before the rename landed)
+            break;
+        }
+        uint16_t id_len;
+        uint16_t name_len;
+        uint8_t status;
+        std::memcpy(&id_len, data + offset, sizeof(id_len));
+        std::memcpy(&name_len, data + offset + 2, sizeof(name_len));
+        std::memcpy(&status, data + offset + 4, sizeof(status));
+        offset += 5;
+        if (offset + id_len + name_len > file_size) {
+            ok = false;
+            break;
+        }
+        upsert(std::string_view(data + offset, id_len),
+               std::string_view(data + offset + id_len, name_len),
+               static_cast<warhorse::WarhorseFriendStatus>(status));
+        offset += id_len + name_len;
+    }
+
+    munmap(const_cast<char*>(data), file_size);
+
+    // The loaded entries are the baseline the next server roster diffs
+    // against, not changes to notify about.
+    dirty.assign(dirty.size(), 0);
+    dirty_count = 0;
+    return ok;
+#endif
+}
+
+bool RosterCache::save_snapshot(const std::string& path) const {
+    std::string tmp_path = path + ".tmp";
+    FILE* file = std::fopen(tmp_path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    uint32_t count = static_cast<uint32_t>(storage.size());
+    bool ok = std::fwrite(SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_LEN, 1, file) == 1 &&
+              std::fwrite(&count, sizeof(count), 1, file) == 1;
+
+    for (const RosterEntry& entry : storage) {
+        if (!ok || entry.id.size() > UINT16_MAX || entry.display_name.size() > UINT16_MAX) {
+            ok = false;
+            break;
+        }
+        uint16_t id_len = static_cast<uint16_t>(entry.id.size());
+        uint16_t name_len = static_cast<uint16_t>(entry.display_name.size());
+        uint8_t status = static_cast<uint8_t>(entry.status);
+        ok = std::fwrite(&id_len, sizeof(id_len), 1, file) == 1 &&
+             std::fwrite(&name_len, sizeof(name_len), 1, file) == 1 &&
+             std::fwrite(&status, sizeof(status), 1, file) == 1 &&
+             (entry.id.empty() || std::fwrite(entry.id.data(), entry.id.size(), 1, file) == 1) &&
+             (entry.display_name.empty() ||
+              std::fwrite(entry.display_name.data(), entry.display_name.size(), 1, file) == 1);
+    }
+
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+    return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+void RosterCache::remove_at(size_t slot) {
+    index.erase(storage[slot].id);
+    if (dirty[slot]) {
+        dirty_count--;
+    }
+    if (slot != storage.size() - 1) {
+        storage[slot] = std::move(storage.back());
+        index[storage[slot].id] = slot;
+        dirty[slot] = dirty.back();
+    }
+    storage.pop_back();
+    dirty.pop_back();
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "include/bindings.h"
+
+struct RosterEntry {
+    std::string id;
+    std::string display_name;
+    warhorse::WarhorseFriendStatus status;
+};
+
+// Indexed roster built from pumped friend events. Entries sit in contiguous
+// storage with a hash index from friend id to slot; full-list events are
+// applied as a diff against the cache, so an unchanged entry costs one
+// compare and a presence flip one field write instead of re-materializing
+// the whole list. (The server still sends full lists today — true delta
+// events need protocol support; this keeps the re-send cheap client-side.)
+class RosterCache {
+public:
+    // Applies a full roster event; entries missing from the list are
+    // removed. Returns the number of entries that actually changed.
+    size_t apply_list(const warhorse::WarhorseFriendRecord* records, size_t count, const char* arena);
+
+    // Applies a single-friend event (request received/accepted).
+    // Returns 1 if the entry changed, 0 otherwise.
+    size_t apply_update(const warhorse::WarhorseFriendRecord& record, const char* arena);
+
+    const std::vector<RosterEntry>& entries() const { return storage; }
+    const RosterEntry* find(std::string_view id) const;
+    size_t size() const { return storage.size(); }
+
+    // Bumped on every change, so consumers can skip refreshes cheaply.
+    uint64_t version() const { return change_version; }
+
+    // Dirty set: entries changed since the last collect_dirty. Marks are
+    // kept as a bitset parallel to storage and survive the swap-erase
+    // compaction, so they cost one byte per entry and no allocation on
+    // the update path.
+    bool has_dirty() const { return dirty_count > 0; }
+
+    // Appends pointers to the changed entries to out and clears the marks.
+    // Returns the number collected; pointers are valid until the next
+    // roster mutation.
+    size_t collect_dirty(std::vector<const RosterEntry*>& out);
+
+    // Local persistence for the startup fast-path. load_snapshot maps the
+    // file and populates the cache in one pointer walk, with the dirty
+    // marks left clear — the snapshot is a baseline, not a change — so the
+    // first server roster applied on top of it diffs down to exactly what
+    // changed while offline. save_snapshot rewrites the file atomically
+    // (write-then-rename). Loading is POSIX-only, like the history scan;
+    // on Windows it reports no snapshot.
+    bool load_snapshot(const std::string& path);
+    bool save_snapshot(const std::string& path) const;
+
+private:
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+    };
+
+    // Returns true if the entry was added or modified.
+    bool upsert(std::string_view id, std::string_view display_name,
+                warhorse::WarhorseFriendStatus status);
+    void remove_at(size_t slot);
+    void mark_dirty(size_t slot);
+
+    std::vector<RosterEntry> storage;
+    std::unordered_map<std::string, size_t, StringHash, std::equal_to<>> index;
+    std::vector<uint8_t> dirty;
+    size_t dirty_count = 0;
+    uint64_t change_version = 0;
+};
@@ -0,0 +1,102 @@
+#include "warhorse_c_api.h"
+
+#include <chrono>
+#include <vector>
+#include "client.h"
+
+// The opaque handle owns the client plus the scratch the pump fills; the
+// wh_event pointers handed out alias the FFI pump arena through these
+// views, hence the valid-until-next-pump contract in the header.
+struct wh_client {
+    WarhorseClient client;
+    std::vector<EventView> views;
+    OutboundBatch batch;
+
+    wh_client(const char* connection_string, uint32_t event_mask)
+        : client(connection_string, 32, event_mask) {}
+};
+
+extern "C" {
+
+uint32_t wh_api_version(void) {
+    return WH_API_VERSION;
+}
+
+wh_client* wh_client_create(const char* connection_string) {
+    return wh_client_create_with_mask(connection_string, EVENT_MASK_ALL);
+}
+
+wh_client* wh_client_create_with_mask(const char* connection_string, uint32_t event_mask) {
+    if (connection_string == nullptr) {
+        return nullptr;
+    }
+    try {
+        return new wh_client(connection_string, event_mask);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void wh_client_destroy(wh_client* client) {
+    delete client;
+}
+
+int wh_client_login(wh_client* client, const char* username, const char* password) {
+    if (client == nullptr || username == nullptr || password == nullptr) {
+        return 0;
+    }
+    return client->client.login(username, password) ? 1 : 0;
+}
+
+size_t wh_client_pump(wh_client* client, wh_event* out_events, size_t max_events) {
+    if (client == nullptr || out_events == nullptr || max_events == 0) {
+        return 0;
+    }
+
+    if (client->views.size() < max_events) {
+        client->views.resize(max_events);
+    }
+    size_t count = client->client.pump_events(
+        std::span<EventView>(client->views.data(), max_events));
+
+    for (size_t i = 0; i < count; i++) {
+        out_events[i].type = static_cast<int32_t>(client->views[i].type);
+        // Arena strings are NUL-terminated, so the pointer doubles as a
+        // C string.
+        out_events[i].message = client->views[i].message.data();
+        out_events[i].message_len = client->views[i].message.size();
+    }
+    return count;
+}
+
+int wh_client_wait(wh_client* client, uint32_t timeout_ms) {
+    if (client == nullptr) {
+        return 0;
+    }
+    return client->client.wait_for_events(std::chrono::milliseconds(timeout_ms)) ? 1 : 0;
+}
+
+size_t wh_client_pending(const wh_client* client) {
+    if (client == nullptr) {
+        return 0;
+    }
+    return client->client.pending_events();
+}
+
+int wh_client_send_room_message(wh_client* client, const char* room, const char* message) {
+    if (client == nullptr || room == nullptr || message == nullptr) {
+        return 0;
+    }
+    client->batch.room_message(room, message);
+    return client->client.send_batch(client->batch) > 0 ? 1 : 0;
+}
+
+int wh_client_send_whisper(wh_client* client, const char* friend_id, const char* message) {
+    if (client == nullptr || friend_id == nullptr || message == nullptr) {
+        return 0;
+    }
+    client->batch.whisper(friend_id, message);
+    return client->client.send_batch(client->batch) > 0 ? 1 : 0;
+}
+
+} // extern "C"
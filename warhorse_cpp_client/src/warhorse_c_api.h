@@ -0,0 +1,65 @@
+#pragma once
+
+// Stable C ABI facade over WarhorseClient, for engines that link the
+// warhorse_client library instead of vendoring these sources. Everything
+// here is plain C: opaque handle, POD event struct, no exceptions across
+// the boundary. The C++ surface (client.h) may change between releases;
+// this one only grows.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bumped whenever the ABI gains entry points; existing ones never change.
+#define WH_API_VERSION 1
+
+// Matches MessageType in client.h, frozen here for ABI purposes.
+typedef enum wh_event_type {
+    WH_EVENT_HELLO = 0,
+    WH_EVENT_LOGGED_IN = 1,
+    WH_EVENT_ERROR = 2,
+    WH_EVENT_FRIEND_REQUESTS = 3,
+    WH_EVENT_FRIENDS_LIST = 4,
+    WH_EVENT_BLOCKED_LIST = 5,
+    WH_EVENT_FRIEND_REQUEST_ACCEPTED = 6,
+    WH_EVENT_CHAT_MESSAGE = 7
+} wh_event_type;
+
+typedef struct wh_client wh_client;
+
+// One pumped event. message is NUL-terminated and, like all pointers
+// handed out by wh_client_pump, valid only until the next pump call.
+typedef struct wh_event {
+    int32_t type;
+    const char* message;
+    size_t message_len;
+} wh_event;
+
+uint32_t wh_api_version(void);
+
+// NULL on failure. event_mask is an OR of (1 << wh_event_type) bits;
+// wh_client_create subscribes to everything.
+wh_client* wh_client_create(const char* connection_string);
+wh_client* wh_client_create_with_mask(const char* connection_string, uint32_t event_mask);
+void wh_client_destroy(wh_client* client);
+
+int wh_client_login(wh_client* client, const char* username, const char* password);
+
+// Fills out_events with up to max_events pumped events; returns the count.
+size_t wh_client_pump(wh_client* client, wh_event* out_events, size_t max_events);
+
+// Blocks up to timeout_ms for events to arrive; returns nonzero if any did.
+int wh_client_wait(wh_client* client, uint32_t timeout_ms);
+
+size_t wh_client_pending(const wh_client* client);
+
+// Outbound ops; queued immediately, one FFI crossing each.
+int wh_client_send_room_message(wh_client* client, const char* room, const char* message);
+int wh_client_send_whisper(wh_client* client, const char* friend_id, const char* message);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif